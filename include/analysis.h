@@ -0,0 +1,36 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include <stdbool.h>
+#include "process.h"
+
+// Limite por omissão do horizonte de simulação para RM/EDF
+#define DEFAULT_HORIZON_CAP 10000000LL
+
+// Resultado de um teste de escalonabilidade (sem simulação)
+typedef struct {
+    bool schedulable;
+    double utilization;
+    double bound;             // Limite de Liu & Layland (apenas RM)
+    int failing_index;        // Índice da primeira tarefa que falha (-1 se nenhuma)
+    long long miss_time;      // EDF: primeiro deadline absoluto violado (-1 se desconhecido)
+} SchedAnalysis;
+
+// Hiperperíodo (mmc dos períodos) em 64 bits; devolve -1 se exceder 'cap'
+long long hyperperiod(const ProcessTable *table, long long cap);
+
+// Horizonte de simulação RM/EDF limitado a 'cap'; *truncated indica se o
+// hiperperíodo completo não coube no limite
+int simulation_horizon(const ProcessTable *table, long long cap, bool *truncated);
+
+// Análise de tempo de resposta exata para Rate Monotonic; se 'response' não
+// for NULL recebe o tempo de resposta de pior caso de cada tarefa (-1 se aperiódica)
+SchedAnalysis analyze_rm(const ProcessTable *table, long long *response);
+
+// Teste de procura de processador para EDF com Quick Processor-demand Analysis
+SchedAnalysis analyze_edf(const ProcessTable *table);
+
+void print_rm_analysis(const ProcessTable *table);
+void print_edf_analysis(const ProcessTable *table);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Arena de memória temporária: as reservas avançam um ponteiro dentro de um
+// bloco e só são libertadas em conjunto, por arena_reset ou arena_free.
+// Quando o bloco não chega é encadeado outro; o reset seguinte junta tudo
+// num único bloco com o maior pico (e alguma folga), pelo que execuções
+// de tamanho semelhante deixam de alocar depois da primeira.
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock *current;    // Bloco em uso (os anteriores estão encadeados)
+    size_t used;            // Bytes reservados desde o último reset
+    size_t peak;            // Maior 'used' observado
+} Arena;
+
+void arena_init(Arena *arena);
+void arena_free(Arena *arena);
+
+// Invalida todas as reservas, mantendo (e consolidando) a memória
+void arena_reset(Arena *arena);
+
+// Reserva alinhada para qualquer tipo, não inicializada; NULL se faltar memória
+void *arena_alloc(Arena *arena, size_t size);
+
+// Reserva de 'count' inteiros, a forma mais comum nos motores
+static inline int *arena_alloc_ints(Arena *arena, int count) {
+    return arena_alloc(arena, (size_t)(count > 0 ? count : 1) * sizeof(int));
+}
+
+#endif
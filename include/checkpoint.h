@@ -0,0 +1,102 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "process.h"
+#include "ready_queue.h"
+
+// Checkpoints de simulações longas (RM/EDF e streaming): o estado completo
+// do motor é gravado a intervalos de tempo simulado e a retoma continua a
+// execução exatamente como se não tivesse sido interrompida. O formato é
+// binário, na ordem de bytes da máquina: cabeçalho seguido das secções do
+// motor, cada array precedido do seu tamanho.
+#define CHECKPOINT_MAGIC 0x4B435350u        // "PSCK"
+#define CHECKPOINT_VERSION 2
+
+// Intervalo por omissão entre checkpoints, em unidades de tempo simulado
+#define CHECKPOINT_DEFAULT_INTERVAL 1000000
+
+typedef enum {
+    CHECKPOINT_PERIODIC,    // RM/EDF sobre uma ProcessTable
+    CHECKPOINT_STREAM       // Streaming sobre uma fonte de processos
+} CheckpointKind;
+
+// Identificação da execução: a retoma só aceita um checkpoint do mesmo
+// motor, parâmetros e carga
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t kind;
+    uint32_t algorithm;
+    int32_t n;              // Processos da tabela (0 em streaming)
+    int32_t parameter;      // Horizonte (RM/EDF) ou quantum (streaming)
+    uint64_t fingerprint;   // Resumo das colunas de entrada (0 em streaming)
+    int32_t time;           // Instante simulado em que foi gravado
+    uint32_t flags;         // Secções opcionais gravadas (CHECKPOINT_JOBS)
+} CheckpointHeader;
+
+// RM/EDF: inclui a contabilidade por job (ver jobs.h)
+#define CHECKPOINT_JOBS 1u
+
+typedef struct {
+    const char *path;       // Destino dos checkpoints (NULL = não grava)
+    int interval;           // Tempo simulado entre checkpoints
+    const char *resume;     // Checkpoint a retomar (NULL = desde o início)
+} CheckpointConfig;
+
+// Resumo FNV-1a das colunas de entrada, para detetar retomas sobre outra carga
+uint64_t checkpoint_fingerprint(const ProcessTable *table);
+
+// Próximo instante de gravação depois de 'time'
+int checkpoint_next_time(const CheckpointConfig *config, int time);
+
+// Escrita num ficheiro temporário, renomeado para 'path' só quando completo:
+// uma interrupção a meio nunca estraga o checkpoint anterior
+typedef struct {
+    FILE *file;
+    const char *path;
+    char *temp_path;
+    bool failed;
+} CheckpointWriter;
+
+int checkpoint_writer_open(CheckpointWriter *w, const char *path, const CheckpointHeader *header);
+void checkpoint_write(CheckpointWriter *w, const void *data, size_t size);
+void checkpoint_write_int(CheckpointWriter *w, int value);
+void checkpoint_write_ints(CheckpointWriter *w, const int *values, int count);
+
+// Conteúdo do heap (índices e chaves pela ordem interna), para que a
+// retoma reconstrua exatamente o mesmo heap
+void checkpoint_write_queue(CheckpointWriter *w, const ReadyQueue *q);
+void checkpoint_write_fifo(CheckpointWriter *w, const FifoQueue *q);
+
+// Devolve 0 se o checkpoint ficou gravado, -1 em erro (mensagem já escrita)
+int checkpoint_writer_close(CheckpointWriter *w);
+
+// Leitura: os erros de formato ficam em 'failed' e são reportados no fecho
+typedef struct {
+    FILE *file;
+    const char *path;
+    bool failed;
+} CheckpointReader;
+
+// Abre e valida o cabeçalho contra 'expected' (time é ignorado); devolve o
+// instante gravado, ou -1 em erro (mensagem já escrita)
+int checkpoint_reader_open(CheckpointReader *r, const char *path, const CheckpointHeader *expected);
+void checkpoint_read(CheckpointReader *r, void *data, size_t size);
+int checkpoint_read_int(CheckpointReader *r);
+
+// Lê exatamente 'count' valores (o tamanho gravado tem de coincidir)
+void checkpoint_read_ints(CheckpointReader *r, int *values, int count);
+
+// Substitui o conteúdo de filas já inicializadas, com capacidade para o
+// conteúdo gravado (nenhuma cresce durante a leitura)
+void checkpoint_read_queue(CheckpointReader *r, ReadyQueue *q);
+void checkpoint_read_fifo(CheckpointReader *r, FifoQueue *q);
+
+// Devolve 0 se todo o checkpoint foi lido sem erros nem dados a mais
+int checkpoint_reader_close(CheckpointReader *r);
+
+#endif
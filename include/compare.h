@@ -0,0 +1,35 @@
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include <stdbool.h>
+#include "process.h"
+#include "scheduler.h"
+#include "stats.h"
+
+// Quantum de RR quando o modo de comparação é pedido sem quantum
+#define COMPARE_DEFAULT_QUANTUM 4
+
+typedef struct {
+    int quantum;            // Apenas RR
+    int horizon;            // Apenas RM/EDF (ver simulation_horizon)
+    int threads;            // Threads usadas (0 = nº de CPUs)
+} CompareConfig;
+
+// Resultado de um algoritmo sobre a carga partilhada
+typedef struct {
+    Algorithm algorithm;
+    SchedulerStats stats;
+    double seconds;         // Tempo de simulação
+    bool ok;
+} CompareResult;
+
+// Simula todos os algoritmos em paralelo sobre a mesma carga, que não é
+// alterada: cada algoritmo usa uma vista com estado e resultados próprios.
+// results recebe ALG_COUNT entradas, pela ordem de Algorithm
+void run_comparison(const ProcessTable *workload, const CompareConfig *config,
+                    CompareResult *results);
+
+// Tabela lado a lado com as estatísticas de cada algoritmo
+void print_comparison(const CompareResult *results, int count);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <stdio.h>
+
+// Instrumentação do simulador: contadores dos caminhos quentes e tempos por
+// fase. Só existe quando compilado com -DPROBSCHED_COUNTERS (make
+// COUNTERS=1); caso contrário as macros não geram código.
+
+typedef struct {
+    long long decisions;          // Processos escolhidos para executar
+    long long context_switches;   // Escolhas de um processo diferente do anterior
+    long long preemptions;        // Trocas que deixam o anterior por terminar
+    long long idle_jumps;         // Saltos da CPU ociosa para o próximo evento
+    long long idle_time;          // Unidades de tempo ociosas saltadas
+    long long releases;           // Jobs libertados (RM/EDF)
+    long long queue_operations;   // Inserções, atualizações e remoções em heaps
+    long long sift_steps;         // Níveis percorridos pelas reordenações do heap
+} SimCounters;
+
+typedef enum {
+    PHASE_GENERATION,
+    PHASE_SIMULATION,
+    PHASE_RENDERING,
+    PHASE_STATS,
+    PHASE_COUNT
+} Phase;
+
+#ifdef PROBSCHED_COUNTERS
+
+// Contadores da thread corrente (cada worker conta sem sincronização)
+extern _Thread_local SimCounters sim_counters;
+
+#define COUNTER_INC(field) (sim_counters.field++)
+#define COUNTER_ADD(field, value) (sim_counters.field += (value))
+#define PHASE_BEGIN(phase) counters_phase_begin(phase)
+#define PHASE_END(phase) counters_phase_end(phase)
+
+void counters_phase_begin(Phase phase);
+void counters_phase_end(Phase phase);
+
+// Soma 'from' a 'into' (p.ex. contagens de outra thread a sim_counters)
+void counters_merge(SimCounters *into, const SimCounters *from);
+
+// Diferença entre duas leituras dos contadores
+void counters_delta(SimCounters *out, const SimCounters *after, const SimCounters *before);
+
+// Contadores da thread corrente e tempos das fases em JSON
+void counters_dump_json(FILE *out);
+
+#else
+
+#define COUNTER_INC(field) ((void)0)
+#define COUNTER_ADD(field, value) ((void)0)
+#define PHASE_BEGIN(phase) ((void)0)
+#define PHASE_END(phase) ((void)0)
+
+#endif
+
+#endif
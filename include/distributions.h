@@ -1,9 +1,29 @@
 #ifndef DISTRIBUTIONS_H
 #define DISTRIBUTIONS_H
 
-int poisson_distribution(double lambda);
-double exponential_distribution(double lambda);
-int uniform_distribution(int min, int max);
-int normal_distribution(int mean, int stddev);
+#include "rng.h"
 
-#endif
\ No newline at end of file
+// Poisson: inversão sequencial para lambda pequeno, PTRS (Hörmann, rejeição
+// transformada com compressão) a partir de POISSON_PTRS_MIN; custo O(1)
+#define POISSON_PTRS_MIN 10.0
+
+int poisson_distribution(Rng *rng, double lambda);
+
+// Exponencial e normal pelo método ziggurat (Marsaglia e Tsang): quase
+// sempre uma palavra aleatória e uma comparação por amostra
+double exponential_distribution(Rng *rng, double lambda);
+
+// Inteiro uniforme em [min, max], sem enviesamento (método de Lemire)
+int uniform_distribution(Rng *rng, int min, int max);
+int normal_distribution(Rng *rng, int mean, int stddev);
+
+// Normal padrão (média 0, desvio 1)
+double standard_normal(Rng *rng);
+
+// Versões em lote: preenchem 'count' amostras consecutivas do mesmo gerador
+void poisson_fill(Rng *rng, double lambda, int *out, int count);
+void exponential_fill(Rng *rng, double lambda, double *out, int count);
+void uniform_fill(Rng *rng, int min, int max, int *out, int count);
+void normal_fill(Rng *rng, int mean, int stddev, int *out, int count);
+
+#endif
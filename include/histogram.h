@@ -0,0 +1,75 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdint.h>
+
+// Histograma de latências com intervalos logarítmicos (à maneira do HDR
+// Histogram): os valores abaixo de HISTOGRAM_SUB_BUCKETS são exatos e cada
+// potência de 2 acima deles é dividida em HISTOGRAM_SUB_BUCKETS / 2
+// intervalos iguais, pelo que o erro relativo de um percentil não passa de
+// 1/128. A memória é fixa para todo o intervalo de int e dois histogramas
+// combinam-se somando as contagens, em tempo constante.
+#define HISTOGRAM_SUB_BITS 8
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS \
+    (HISTOGRAM_SUB_BUCKETS + (31 - HISTOGRAM_SUB_BITS) * (HISTOGRAM_SUB_BUCKETS / 2))
+
+typedef struct {
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t count;
+    int max;            // Maior valor registado (exato)
+} Histogram;
+
+void histogram_reset(Histogram *h);
+
+static inline int histogram_bucket(int value) {
+    if (value < HISTOGRAM_SUB_BUCKETS) return value < 0 ? 0 : value;
+    int octave = 31 - __builtin_clz((unsigned)value);
+    int shift = octave - HISTOGRAM_SUB_BITS + 1;
+    return HISTOGRAM_SUB_BUCKETS + (octave - HISTOGRAM_SUB_BITS) * (HISTOGRAM_SUB_BUCKETS / 2) +
+           ((value >> shift) - HISTOGRAM_SUB_BUCKETS / 2);
+}
+
+// Valores negativos contam como 0
+static inline void histogram_record(Histogram *h, int value) {
+    h->counts[histogram_bucket(value)]++;
+    h->count++;
+    if (value > h->max) h->max = value;
+}
+
+void histogram_merge(Histogram *into, const Histogram *from);
+
+// Menor valor v tal que pelo menos 'percentile'% dos registos são <= v,
+// arredondado para o limite superior do intervalo (nunca acima do máximo);
+// 0 se o histograma estiver vazio
+int histogram_percentile(const Histogram *h, double percentile);
+
+// Os mesmos intervalos, guardando só os não vazios por ordem de intervalo:
+// para muitos histogramas pequenos (um por tarefa em jobs.h), em que os
+// HISTOGRAM_BUCKETS contadores fixos seriam quase todos zero
+typedef struct {
+    int bucket;
+    uint64_t count;
+} HistogramBin;
+
+typedef struct {
+    HistogramBin *bins;
+    int size;
+    int capacity;
+    uint64_t count;
+    int max;
+} SparseHistogram;
+
+void sparse_histogram_init(SparseHistogram *h);
+void sparse_histogram_free(SparseHistogram *h);
+
+// Esvazia, mantendo a memória
+void sparse_histogram_reset(SparseHistogram *h);
+
+// Como histogram_record; devolve -1 se faltar memória para um novo intervalo
+int sparse_histogram_record(SparseHistogram *h, int value);
+
+// Como histogram_percentile
+int sparse_histogram_percentile(const SparseHistogram *h, double percentile);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "histogram.h"
+#include "process.h"
+#include "stats.h"
+#include "checkpoint.h"
+
+// Contabilidade por job das tarefas de RM/EDF. A tabela só guarda o último
+// job de cada tarefa; aqui cada job é acumulado quando termina ou é
+// descartado, pelo que a memória por tarefa não cresce com o número de
+// libertações simuladas, só com o de intervalos de resposta distintos.
+typedef struct {
+    long long completed;        // Jobs concluídos (a tempo ou atrasados)
+    long long late;             // Concluídos depois do deadline
+    long long dropped;          // Por terminar na libertação seguinte ou no fim do horizonte
+    RunningStat response;       // Resposta do job: conclusão - libertação
+    int worst_response;
+    int worst_start_delay;      // Maior atraso entre a libertação e o início
+    int worst_lateness;         // Maior conclusão - deadline (negativo se houver folga)
+    SparseHistogram response_histogram;   // Último campo (ver job_stats_save)
+} TaskJobStats;
+
+typedef struct {
+    int n;
+    TaskJobStats *tasks;        // Um por linha da tabela
+} JobStats;
+
+// Devolve 0 em sucesso, -1 se faltar memória
+int job_stats_init(JobStats *jobs, int n);
+void job_stats_free(JobStats *jobs);
+void job_stats_reset(JobStats *jobs);
+
+// Job da tarefa i libertado em 'release', iniciado em 'start' e concluído
+// em 'finish', com deadline absoluto 'deadline'; devolve -1 se faltar
+// memória para o histograma
+int job_stats_complete(JobStats *jobs, int i, int release, int start, int finish,
+                       int deadline);
+
+// Job da tarefa i que perdeu o deadline sem terminar
+static inline void job_stats_drop(JobStats *jobs, int i) {
+    jobs->tasks[i].dropped++;
+}
+
+// Secção dos checkpoints com os acumuladores das jobs->n tarefas; os
+// histogramas só levam os intervalos não vazios. A leitura substitui o
+// conteúdo de 'jobs', já iniciado com o mesmo número de tarefas
+void job_stats_save(const JobStats *jobs, CheckpointWriter *w);
+void job_stats_load(JobStats *jobs, CheckpointReader *r);
+
+// Tabela por tarefa: jobs, atrasos, resposta média, percentis e piores casos
+void print_job_stats(const JobStats *jobs, const ProcessTable *table);
+
+#endif
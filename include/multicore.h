@@ -0,0 +1,41 @@
+#ifndef MULTICORE_H
+#define MULTICORE_H
+
+#include "process.h"
+#include "scheduler.h"
+
+// Organização do escalonamento em várias CPUs
+typedef enum {
+    MULTICORE_GLOBAL,       // Uma fila de prontos partilhada, com migração
+    MULTICORE_PARTITIONED   // Cada processo fica fixo numa CPU com fila própria
+} MulticoreMode;
+
+typedef struct {
+    MulticoreMode mode;
+    int cpus;
+    int quantum;            // Apenas RR
+    int horizon;            // Apenas RM/EDF (ver simulation_horizon)
+    int threads;            // Threads para simular partições (0 = nº de CPUs)
+} MulticoreConfig;
+
+// Simula 'algorithm' em config->cpus CPUs. Em modo global as m tarefas de
+// maior prioridade executam em simultâneo (preempção da menos prioritária
+// nos algoritmos preemptivos); em modo particionado cada processo é atribuído
+// à CPU menos carregada (por utilização decrescente em RM/EDF, por ordem de
+// chegada nos restantes) e cada partição é simulada pelo motor de uma CPU.
+// busy_time (config->cpus entradas) recebe o tempo ocupado de cada CPU.
+// Devolve 0 em sucesso, -1 se faltar memória (ou CFS em modo global, que não
+// é suportado, ou RR com quantum não positivo).
+int run_multicore(Algorithm algorithm, ProcessTable *table, const MulticoreConfig *config,
+                  long long *busy_time);
+
+// Como run_multicore, com a memória temporária de 'ctx' (ver SimContext); no
+// modo particionado cada worker recebe também um contexto próprio, criado
+// na arena de 'ctx' e reutilizado entre as CPUs que simula
+int run_multicore_in(SimContext *ctx, Algorithm algorithm, ProcessTable *table,
+                     const MulticoreConfig *config, long long *busy_time);
+
+// Utilização de cada CPU no intervalo [0, total_time)
+void print_cpu_utilization(const long long *busy_time, int cpus, int total_time);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdint.h>
+#include "process.h"
+
+// Formatos de saída dos resultados por processo
+typedef enum {
+    OUTPUT_TABLE,       // Tabela formatada no terminal
+    OUTPUT_CSV,         // CSV escrito em blocos grandes
+    OUTPUT_BINARY       // Colunas int32, sem formatação
+} OutputFormat;
+
+// Converte o nome da linha de comandos ("table", "csv", "binary"); -1 se desconhecido
+int parse_output_format(const char *name);
+
+// Ficheiro de resultados usado por omissão em cada formato
+const char *output_default_path(OutputFormat format);
+
+// Formato binário de resultados: cabeçalho seguido de uma coluna int32 por
+// campo, pela ordem pid, chegada, burst, prioridade, deadline, período,
+// conclusão, espera, deadlines perdidos e resposta, cada uma alinhada a
+// RESULTS_ALIGN (a versão 1 não tinha a coluna de resposta)
+#define RESULTS_MAGIC 0x53525350u       // "PSRS"
+#define RESULTS_VERSION 2
+#define RESULTS_COLUMNS 10
+#define RESULTS_ALIGN 64
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t columns;
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t column_offset[RESULTS_COLUMNS];
+} ResultsHeader;
+
+// Escreve os resultados em 'path' no formato CSV ou binário.
+// Devolve 0 em sucesso, -1 em erro (mensagem já escrita).
+int write_results(const ProcessTable *table, OutputFormat format, const char *path);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// Tarefa executada para cada índice; 'worker' identifica a thread (0..threads-1)
+// e permite usar estado privado por thread sem sincronização
+typedef void (*ParallelTask)(int index, int worker, void *arg);
+
+// Executa task para todos os índices em [0, count) com 'threads' workers
+// (a thread chamadora é o worker 0); os índices são distribuídos dinamicamente
+void parallel_for(int count, int threads, ParallelTask task, void *arg);
+
+// Número de CPUs disponíveis (pelo menos 1)
+int default_thread_count(void);
+
+#endif
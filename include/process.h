@@ -2,6 +2,8 @@
 #define PROCESS_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "arena.h"
 
 typedef struct {
     int pid;
@@ -13,11 +15,83 @@ typedef struct {
     int period;
     int completion_time;
     int waiting_time;
+    int response_time;    // Primeira execução - chegada (do job corrente em RM/EDF)
     int deadline_misses;  // Adicionado para tempo real
 } Process;
 
-Process *generate_processes(int n, bool real_time);
-void free_processes(Process *processes);
-void reset_processes(Process *processes, int n);
+// Tabela de processos em estrutura de arrays: cada campo é uma coluna
+// contígua, pelo que os ciclos dos motores só trazem para a cache os campos
+// que usam. Os atributos da carga são só de leitura durante a simulação,
+// remaining_time é o estado quente e os resultados (frios) só são escritos
+// quando um processo termina ou perde um deadline
+typedef struct {
+    int n;
+
+    // Atributos da carga
+    int *pid;
+    int *arrival_time;
+    int *burst_time;
+    int *priority;
+    int *deadline;
+    int *period;
+
+    // Estado da simulação
+    int *remaining_time;
+
+    // Resultados
+    int *completion_time;
+    int *waiting_time;
+    int *response_time;
+    int *deadline_misses;
+
+    int *columns;       // Bloco das colunas de entrada (NULL se forem externas)
+    int *state;         // Bloco que aloja o estado e os resultados
+
+    // Índices por ordem de chegada, partilhados pelos motores (NULL até
+    // process_table_index_arrivals; inválido se arrival_time mudar)
+    int *arrival_order;
+    bool borrowed;      // Colunas de entrada e índice pertencem a outra tabela
+} ProcessTable;
+
+int process_table_init(ProcessTable *table, int n);
+
+// Aloca apenas o estado e os resultados; as colunas de entrada são apontadas
+// pelo chamador para memória externa (ex.: um ficheiro mapeado)
+int process_table_init_state(ProcessTable *table, int n);
+void process_table_free(ProcessTable *table);
+
+// Tabela com as colunas na arena, válida até ao reset seguinte; o estado e
+// os resultados começam a zero e process_table_free só liberta o índice de
+// chegadas, se tiver sido construído
+int process_table_init_arena(ProcessTable *table, int n, Arena *arena);
+
+// Vista sobre a carga de 'source' com estado e resultados próprios: as
+// colunas de entrada e o índice de chegadas são partilhados e só lidos,
+// pelo que várias vistas podem ser simuladas em paralelo
+int process_table_init_view(ProcessTable *view, const ProcessTable *source);
+
+// Conversão entre uma linha da tabela e a estrutura Process
+void process_table_get(const ProcessTable *table, int i, Process *process);
+void process_table_set(ProcessTable *table, int i, const Process *process);
+
+// Repõe o estado e os resultados, mantendo a carga
+void process_table_reset(ProcessTable *table);
+
+// Constrói arrival_order (ordenação linear por chegada), uma vez por carga
+int process_table_index_arrivals(ProcessTable *table);
+
+// Preenche a tabela (já inicializada) a partir da semente; o processo i
+// depende apenas de (seed, i)
+void generate_processes(ProcessTable *table, bool real_time, uint64_t seed);
+void generate_process(Process *process, int index, bool real_time, uint64_t seed);
+
+// Variante para modo streaming: as chegadas formam um processo de renovação
+// (intervalos Poisson de média mean_interarrival), já por ordem de chegada
+void generate_stream_process(Process *process, int index, int previous_arrival,
+                             double mean_interarrival, uint64_t seed);
+
+// Deadline relativo da tarefa i (deadline - chegada, ou o período quando o
+// deadline não está definido)
+int process_relative_deadline(const ProcessTable *table, int i);
 
 #endif
\ No newline at end of file
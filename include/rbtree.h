@@ -0,0 +1,37 @@
+#ifndef RBTREE_H
+#define RBTREE_H
+
+#include <stdbool.h>
+#include "arena.h"
+
+// Árvore rubro-negra sobre índices de processos, ordenada por (chave, índice),
+// com o mínimo em cache. Os nós vivem em arrays indexados pelo processo (sem
+// alocações por inserção); o índice 'capacity' é a sentinela nula.
+// Inserção e remoção O(log n), mínimo O(1).
+typedef struct {
+    int *left;
+    int *right;
+    int *parent;
+    bool *red;
+    long long *key;
+    int root;
+    int leftmost;   // Nó de menor chave (-1 se vazia)
+    int size;
+    int capacity;
+} RbTree;
+
+int rb_tree_init(RbTree *t, int capacity);
+void rb_tree_free(RbTree *t);
+
+// Árvore sobre memória da arena (não se liberta com rb_tree_free)
+int rb_tree_init_arena(RbTree *t, int capacity, Arena *arena);
+
+// 'id' não pode estar já na árvore
+void rb_tree_insert(RbTree *t, int id, long long key);
+void rb_tree_remove(RbTree *t, int id);
+
+static inline int rb_tree_first(const RbTree *t) { return t->leftmost; }
+static inline bool rb_tree_empty(const RbTree *t) { return t->size == 0; }
+static inline long long rb_tree_key(const RbTree *t, int id) { return t->key[id]; }
+
+#endif
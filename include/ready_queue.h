@@ -0,0 +1,105 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <stdbool.h>
+#include "process.h"
+#include "arena.h"
+
+// Fila de prontos: heap binário mínimo indexado sobre índices de processos.
+// A ordem é (chave, índice), pelo que empates são resolvidos pelo menor índice,
+// tal como nas antigas pesquisas lineares. Todas as operações são O(log n).
+typedef struct {
+    int *heap;      // índices dos processos, em ordem de heap
+    int *pos;       // posição de cada índice no heap (-1 se ausente)
+    int *key;       // chave atual de cada índice (burst, prioridade, deadline...)
+    const int *tiebreak;  // desempate opcional por tiebreak[índice] antes do índice
+    int size;
+    int capacity;
+} ReadyQueue;
+
+int ready_queue_init(ReadyQueue *q, int capacity);
+void ready_queue_free(ReadyQueue *q);
+
+// Fila sobre memória da arena: dura até ao reset da arena e não pode ser
+// libertada com ready_queue_free nem crescer com ready_queue_reserve
+int ready_queue_init_arena(ReadyQueue *q, int capacity, Arena *arena);
+
+// Aumenta o número de índices suportados (para filas sobre pools que crescem)
+int ready_queue_reserve(ReadyQueue *q, int capacity);
+
+// Igual, para filas da arena: o conteúdo é copiado para memória nova da
+// arena e a antiga só é recuperada no reset
+int ready_queue_reserve_arena(ReadyQueue *q, int capacity, Arena *arena);
+
+// Esvazia a fila em O(tamanho), mantendo a capacidade
+void ready_queue_clear(ReadyQueue *q);
+
+void ready_queue_push(ReadyQueue *q, int id, int key);
+void ready_queue_update(ReadyQueue *q, int id, int key);
+void ready_queue_remove(ReadyQueue *q, int id);
+int ready_queue_pop(ReadyQueue *q);
+
+static inline bool ready_queue_empty(const ReadyQueue *q) { return q->size == 0; }
+static inline int ready_queue_peek(const ReadyQueue *q) { return q->size ? q->heap[0] : -1; }
+static inline bool ready_queue_contains(const ReadyQueue *q, int id) { return q->pos[id] >= 0; }
+static inline int ready_queue_key(const ReadyQueue *q, int id) { return q->key[id]; }
+
+// Fila FIFO circular (Round Robin): push/pop em O(1), capacidade cresce
+// por duplicação quando cheia
+typedef struct {
+    int *items;
+    int head;
+    int size;
+    int capacity;
+} FifoQueue;
+
+int fifo_queue_init(FifoQueue *q, int capacity);
+void fifo_queue_free(FifoQueue *q);
+
+// Fila sobre memória da arena, com capacidade fixa: nunca pode receber mais
+// de 'capacity' elementos em simultâneo
+int fifo_queue_init_arena(FifoQueue *q, int capacity, Arena *arena);
+
+// Aumenta a capacidade de uma fila da arena (ver ready_queue_reserve_arena)
+int fifo_queue_reserve_arena(FifoQueue *q, int capacity, Arena *arena);
+int fifo_queue_push(FifoQueue *q, int id);
+int fifo_queue_pop(FifoQueue *q);
+
+static inline bool fifo_queue_empty(const FifoQueue *q) { return q->size == 0; }
+
+// Ordena os índices 0..n-1 por key, de forma estável (empates pelo menor
+// índice), em tempo linear: contagem direta se o intervalo das chaves for
+// pequeno, radix LSD em dígitos de 8 bits caso contrário.
+// Devolve -1 se faltar memória
+int sort_index_by_key(const int *key, int n, int *order);
+
+// Igual, com a memória auxiliar tirada da arena
+int sort_index_by_key_arena(const int *key, int n, int *order, Arena *arena);
+
+// Cursor sobre os processos por ordem de chegada: cada processo é
+// visitado uma única vez, quando chega
+typedef struct {
+    const int *order;           // Índices ordenados por (arrival_time, índice)
+    const int *arrival_time;    // Coluna de chegadas (não copiada)
+    int n;
+    int next;
+    bool owns_order;            // order foi alocado pelo cursor
+} ArrivalCursor;
+
+int arrival_cursor_init(ArrivalCursor *c, const int *arrival_time, int n);
+
+// Usa o índice de chegadas da tabela, se existir, ou ordena as chegadas
+int arrival_cursor_open(ArrivalCursor *c, const ProcessTable *table);
+
+// Igual, mas a ordenação (se a tabela não tiver índice) fica na arena
+int arrival_cursor_open_arena(ArrivalCursor *c, const ProcessTable *table, Arena *arena);
+void arrival_cursor_free(ArrivalCursor *c);
+
+// Tempo da próxima chegada ainda não consumida (INT_MAX se não houver)
+int arrival_cursor_peek_time(const ArrivalCursor *c);
+
+// Devolve o índice do próximo processo com arrival_time <= now e avança o
+// cursor, ou -1 se ainda não chegou mais nenhum
+int arrival_cursor_next(ArrivalCursor *c, int now);
+
+#endif
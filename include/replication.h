@@ -0,0 +1,24 @@
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include <stdint.h>
+#include "scheduler.h"
+#include "stats.h"
+
+// Configuração de uma série de replicações Monte-Carlo independentes
+typedef struct {
+    Algorithm algorithm;
+    int num_processes;
+    int quantum;
+    long long horizon_cap;
+    uint64_t seed;
+    int replications;
+    int threads;
+} ReplicationConfig;
+
+// Executa as replicações em paralelo; cada replicação usa uma carga gerada
+// com uma semente derivada de (seed, replicação). Devolve 0 em sucesso, -1
+// se faltar memória.
+int run_replications(const ReplicationConfig *config, StatsAccumulator *result);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Gerador baseado em contador (Philox4x32-10): cada valor é uma função pura de
+// (semente, substream, contador), pelo que substreams diferentes são
+// independentes e qualquer posição pode ser recalculada sem estado partilhado.
+typedef struct {
+    uint32_t key[2];      // Semente
+    uint32_t counter[4];  // [0..1] posição no substream, [2..3] identificador do substream
+    uint32_t buffer[4];   // Último bloco gerado
+    int available;        // Palavras de 'buffer' ainda por consumir
+} Rng;
+
+void rng_init(Rng *rng, uint64_t seed, uint64_t stream);
+
+// Bloco Philox4x32-10 para um contador e chave arbitrários
+void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+uint32_t rng_next_u32(Rng *rng);
+uint64_t rng_next_u64(Rng *rng);
+
+// Semente independente para a réplica/tarefa 'index' derivada de 'seed'
+uint64_t rng_derive_seed(uint64_t seed, uint64_t index);
+
+// Uniforme em (0, 1) com 53 bits de resolução (nunca devolve 0 nem 1)
+double rng_uniform(Rng *rng);
+
+#endif
@@ -3,21 +3,117 @@
 
 #include "process.h"
 #include "stats.h"
+#include "trace.h"
+#include "checkpoint.h"
+#include "arena.h"
+#include "jobs.h"
+
+#include <stdbool.h>
+
+// Algoritmos disponíveis
+typedef enum {
+    ALG_FCFS,
+    ALG_SJF,
+    ALG_PRIORITY_NP,
+    ALG_PRIORITY_P,
+    ALG_RR,
+    ALG_RM,
+    ALG_EDF,
+    ALG_CFS,
+    ALG_COUNT
+} Algorithm;
+
+// Converte o nome da linha de comandos (ex.: "PRIORITY_P"); -1 se desconhecido
+int parse_algorithm(const char *name);
+const char *algorithm_name(Algorithm algorithm);
+const char *algorithm_description(Algorithm algorithm);
+bool algorithm_is_real_time(Algorithm algorithm);
+
+// Executa o algoritmo indicado; 'quantum' só é usado por RR (e por CFS como
+// granularidade mínima) e 'horizon' por RM/EDF. Devolve 0 em sucesso, -1 se
+// faltar memória (a tabela fica então incompleta) ou se RR receber um
+// quantum não positivo
+int run_algorithm(Algorithm algorithm, ProcessTable *table, int quantum, int horizon,
+                  Trace *trace);
+
+// Intervalo a que se referem as estatísticas: o horizonte em RM/EDF, cujas
+// tarefas são libertadas até ao fim dele, o fim da simulação nos restantes
+int algorithm_total_time(Algorithm algorithm, const ProcessTable *table, int horizon);
+
+// Estatísticas de uma execução sobre algorithm_total_time, com a utilização
+// do tempo ocupado medido em cada uma das 'cpus' (ver Trace.busy_time): em
+// RM/EDF a tabela só guarda o último job de cada tarefa e a soma dos bursts
+// não mede o trabalho feito
+SchedulerStats algorithm_stats(Algorithm algorithm, const ProcessTable *table, int horizon,
+                               const long long *busy_time, int cpus);
+
+// Contexto de simulação: a memória temporária dos motores (filas, cursor de
+// chegadas, arrays auxiliares) vem da arena, esvaziada no início de cada
+// execução. Reutilizado entre execuções deixa de alocar depois da maior
+// delas; não pode ser partilhado por threads em simultâneo
+typedef struct {
+    Arena arena;
+} SimContext;
+
+void sim_context_init(SimContext *ctx);
+void sim_context_free(SimContext *ctx);
+
+// Como run_algorithm, com a memória temporária de 'ctx'. As variantes _in
+// de cada motor recebem o contexto do chamador; as que não o recebem são
+// apenas pontos de entrada que criam e libertam um temporário
+int run_algorithm_in(SimContext *ctx, Algorithm algorithm, ProcessTable *table, int quantum,
+                     int horizon, Trace *trace);
+
+// Todos os motores leem a carga das colunas de 'table' sem a reordenar,
+// escrevem remaining_time e os resultados, e registam a execução em 'trace'
+// (pode ser NULL), que é depois desenhado por print_gantt sem voltar a simular;
+// como run_algorithm, devolvem -1 se faltar memória
 
 // Declarações de funções para algoritmos básicos
-void run_fcfs(Process *processes, int n);
-void run_sjf(Process *processes, int n);
+int run_fcfs(ProcessTable *table, Trace *trace);
+int run_sjf(ProcessTable *table, Trace *trace);
 
 // Funções para Priority Scheduling
-void run_priority_nonpreemptive(Process *processes, int n);
-void run_priority_preemptive(Process *processes, int n);
+int run_priority_nonpreemptive(ProcessTable *table, Trace *trace);
+int run_priority_preemptive(ProcessTable *table, Trace *trace);
 
 // Round Robin
-void run_rr(Process *processes, int n, int quantum);
+int run_rr(ProcessTable *table, int quantum, Trace *trace);
+
+// CFS: granularidade mínima por omissão e latência alvo em múltiplos da
+// granularidade (como sched_nr_latency no Linux)
+#define CFS_DEFAULT_MIN_GRANULARITY 1
+#define CFS_LATENCY_FACTOR 8
+
+// Completely Fair Scheduler: os processos prontos estão numa árvore
+// rubro-negra ordenada pelo tempo virtual, que avança na razão inversa do
+// peso derivado da prioridade. Cada processo executa uma fatia proporcional
+// ao seu peso de 'latency' (ou de min_granularity por processo, se houver
+// mais de latency / min_granularity prontos)
+int run_cfs(ProcessTable *table, int latency, int min_granularity, Trace *trace);
+int run_cfs_in(SimContext *ctx, ProcessTable *table, int latency, int min_granularity,
+               Trace *trace);
+
+// Algoritmos de tempo real, simulados no intervalo [0, horizon)
+// (ver simulation_horizon em analysis.h)
+int run_rate_monotonic(ProcessTable *table, int horizon, Trace *trace);
+int run_edf(ProcessTable *table, int horizon, Trace *trace);
+
+// RM/EDF com checkpoints periódicos e/ou retoma (ver checkpoint.h); o traço
+// só tem os segmentos da parte simulada nesta execução, mas o tempo ocupado
+// inclui o gravado no checkpoint. Devolve 0 em sucesso, -1 se
+// faltar memória, o algoritmo não for periódico ou a retoma falhar
+int run_real_time_checkpointed(Algorithm algorithm, ProcessTable *table, int horizon,
+                               Trace *trace, const CheckpointConfig *checkpoint);
 
-// Algoritmos de tempo real
-void run_rate_monotonic(Process *processes, int n);
-void run_edf(Process *processes, int n);
+// Como run_real_time_checkpointed ('checkpoint' pode ser NULL), acumulando
+// cada job em 'jobs', iniciado com table->n tarefas; os checkpoints gravam
+// também os acumuladores
+int run_real_time_jobs(Algorithm algorithm, ProcessTable *table, int horizon, Trace *trace,
+                       const CheckpointConfig *checkpoint, JobStats *jobs);
+int run_real_time_jobs_in(SimContext *ctx, Algorithm algorithm, ProcessTable *table,
+                          int horizon, Trace *trace, const CheckpointConfig *checkpoint,
+                          JobStats *jobs);
 
 // Funções auxiliares
 int gcd(int a, int b);
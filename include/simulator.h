@@ -0,0 +1,66 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdbool.h>
+#include "process.h"
+#include "scheduler.h"
+#include "stats.h"
+#include "trace.h"
+
+// Simulador incremental para uso como biblioteca (libprobsched): os
+// processos são acrescentados com a simulação em curso e o tempo avança
+// até um instante ou até ao evento seguinte, podendo o estado de cada
+// processo e as estatísticas ser consultados a qualquer momento.
+// Com todos os processos acrescentados pela ordem dos índices, os
+// resultados coincidem com os dos motores de run_algorithm.
+typedef struct Simulator Simulator;
+
+// Devolve NULL se faltar memória ou o algoritmo não for suportado (CFS);
+// 'quantum' só é usado por RR e tem de ser positivo
+Simulator *simulator_create(Algorithm algorithm, int quantum);
+
+// Como simulator_create, com toda a memória da simulação na arena de 'ctx'
+// (ver SimContext), que fica reservada ao simulador até simulator_destroy
+// e pode depois ser reutilizada por outro simulador ou motor
+Simulator *simulator_create_in(SimContext *ctx, Algorithm algorithm, int quantum);
+void simulator_destroy(Simulator *sim);
+
+// Esquece todos os processos e volta ao instante 0, mantendo a memória já
+// reservada, para repetir simulações sem alocações
+void simulator_reset(Simulator *sim);
+
+// Regista a execução em 'trace' (NULL desativa), como nos motores
+void simulator_set_trace(Simulator *sim, Trace *trace);
+
+// Acrescenta um processo (remaining_time e os resultados são ignorados);
+// a chegada não pode ser anterior ao instante atual. Devolve o índice do
+// processo, usado nas consultas, ou -1 em erro
+int simulator_add_process(Simulator *sim, const Process *process);
+
+// Simula até 'time' (sem efeito se já lá estiver); devolve o instante atual
+int simulator_advance_to(Simulator *sim, int time);
+
+// Avança até ao próximo ponto de decisão: fim de um segmento de execução
+// (conclusão, fim do quantum ou preempção) ou chegada/libertação com a CPU
+// ociosa. Devolve false se não houver mais nada a simular
+bool simulator_step(Simulator *sim);
+
+// Simula até não haver processos por terminar nem chegadas pendentes;
+// devolve -1 para RM/EDF, cujas tarefas periódicas não terminam
+int simulator_run(Simulator *sim);
+
+int simulator_time(const Simulator *sim);
+int simulator_process_count(const Simulator *sim);
+
+// Processos concluídos (em RM/EDF, tarefas com pelo menos um job concluído)
+int simulator_completed(const Simulator *sim);
+
+// Estado atual do processo 'id'; devolve -1 se o índice não existir
+int simulator_get_process(const Simulator *sim, int id, Process *process);
+
+// Estatísticas dos processos concluídos até agora, sobre o tempo decorrido;
+// em RM/EDF os jobs pendentes com o deadline ultrapassado contam como
+// perdidos, tal como no fim do horizonte dos motores
+SchedulerStats simulator_stats(const Simulator *sim);
+
+#endif
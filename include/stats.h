@@ -1,17 +1,110 @@
 #ifndef STATS_H
 #define STATS_H
 
+#include <stdbool.h>
 #include "process.h"
+#include "histogram.h"
+
+// Percentis de uma latência, lidos de um histograma
+typedef struct {
+    int p50;
+    int p90;
+    int p99;
+    int p999;
+    int max;
+} LatencyPercentiles;
 
 typedef struct {
     float avg_waiting_time;
     float avg_turnaround_time;
+    float avg_response_time;        // Primeira execução - chegada
     float cpu_utilization;
     float throughput;
     int deadline_misses;
+    int cpus;
+    float min_cpu_utilization;      // Utilização da CPU menos ocupada
+    float max_cpu_utilization;      // Utilização da CPU mais ocupada
+
+    // Só preenchidos por stats_set_percentiles (has_percentiles)
+    bool has_percentiles;
+    LatencyPercentiles waiting_percentiles;
+    LatencyPercentiles turnaround_percentiles;
+    LatencyPercentiles response_percentiles;
 } SchedulerStats;
 
-SchedulerStats calculate_stats(Process *processes, int n, int total_time);
+SchedulerStats calculate_stats(const ProcessTable *table, int total_time);
+
+// Distribuição das latências dos processos concluídos, em memória fixa e
+// combinável entre threads e replicações em tempo constante
+typedef struct {
+    Histogram waiting_time;
+    Histogram turnaround_time;
+    Histogram response_time;
+} LatencyHistograms;
+
+void latency_histograms_reset(LatencyHistograms *latency);
+void latency_histograms_add(LatencyHistograms *latency, const Process *completed);
+
+// Acrescenta os processos concluídos da tabela (completion_time > 0)
+void latency_histograms_add_table(LatencyHistograms *latency, const ProcessTable *table);
+void latency_histograms_merge(LatencyHistograms *into, const LatencyHistograms *from);
+void stats_set_percentiles(SchedulerStats *stats, const LatencyHistograms *latency);
+
+// Percentis dos processos concluídos de 'table', com histogramas
+// temporários; devolve -1 se faltar memória
+int calculate_percentiles(const ProcessTable *table, SchedulerStats *stats);
+
+// Substitui a utilização de uma CPU pela média e extremos das 'cpus' CPUs
+void stats_set_cpu_usage(SchedulerStats *stats, const long long *busy_time, int cpus,
+                         int total_time);
 void print_stats(SchedulerStats stats);
 
-#endif
\ No newline at end of file
+// Instante em que termina o último processo (tempo total de execução)
+int simulation_end_time(const ProcessTable *table);
+
+// Média e variância incrementais (Welford), combináveis entre threads
+typedef struct {
+    long long count;
+    double mean;
+    double m2;       // Soma dos quadrados dos desvios à média
+} RunningStat;
+
+void running_stat_add(RunningStat *stat, double value);
+void running_stat_merge(RunningStat *into, const RunningStat *from);
+double running_stat_variance(const RunningStat *stat);
+
+// Semi-amplitude do intervalo de confiança a 95% para a média (t de Student)
+double running_stat_ci95(const RunningStat *stat);
+
+// Acumuladores online para processos retirados em modo streaming: cada
+// processo é contabilizado ao terminar e pode ser libertado de seguida
+typedef struct {
+    RunningStat waiting_time;
+    RunningStat turnaround_time;
+    RunningStat response_time;
+    LatencyHistograms latency;
+    long long busy_time;
+    int end_time;
+    long long deadline_misses;
+} OnlineStats;
+
+void online_stats_add(OnlineStats *online, const Process *retired);
+SchedulerStats online_stats_result(const OnlineStats *online);
+
+// Agregado de SchedulerStats ao longo de várias replicações; 'latency'
+// junta os processos de todas as replicações (latency_histograms_add_table)
+typedef struct {
+    RunningStat waiting_time;
+    RunningStat turnaround_time;
+    RunningStat response_time;
+    RunningStat cpu_utilization;
+    RunningStat throughput;
+    RunningStat deadline_misses;
+    LatencyHistograms latency;
+} StatsAccumulator;
+
+void stats_accumulator_add(StatsAccumulator *acc, SchedulerStats stats);
+void stats_accumulator_merge(StatsAccumulator *into, const StatsAccumulator *from);
+void print_stats_summary(const StatsAccumulator *acc);
+
+#endif
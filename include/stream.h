@@ -0,0 +1,59 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "process.h"
+#include "scheduler.h"
+#include "stats.h"
+#include "checkpoint.h"
+
+// Intervalo médio entre chegadas da carga gerada em streaming (carga ~0.85
+// com bursts normal(5, 3))
+#define STREAM_DEFAULT_INTERARRIVAL 6.0
+
+// Fonte de processos por ordem de chegada, consumida preguiçosamente
+typedef struct ProcessSource ProcessSource;
+struct ProcessSource {
+    // Preenche *out com o próximo processo; devolve false no fim da carga
+    bool (*next)(ProcessSource *source, Process *out);
+
+    // Estado da fonte para checkpoints (NULL se a fonte não puder ser
+    // retomada); restore valida que o checkpoint é desta fonte
+    void (*save)(ProcessSource *source, CheckpointWriter *w);
+    void (*restore)(ProcessSource *source, CheckpointReader *r);
+};
+
+// Fonte gerada a partir da semente, sem materializar a carga
+typedef struct {
+    ProcessSource base;
+    int count;
+    int produced;
+    int last_arrival;
+    double mean_interarrival;
+    uint64_t seed;
+} GeneratedSource;
+
+void generated_source_init(GeneratedSource *source, int count, uint64_t seed,
+                           double mean_interarrival);
+
+typedef struct {
+    OnlineStats online;
+    int peak_live;       // Máximo de processos simultaneamente em memória
+} StreamResult;
+
+// Simula um algoritmo não periódico sobre a fonte; cada processo só existe
+// em memória entre a chegada e a conclusão. Com 'checkpoint' (pode ser NULL)
+// grava e/ou retoma o estado completo da simulação e da fonte. Devolve 0 em
+// sucesso, -1 se o algoritmo não suportar streaming (RM/EDF), RR receber um
+// quantum não positivo, faltar memória ou a retoma falhar.
+int run_stream(Algorithm algorithm, ProcessSource *source, int quantum,
+               const CheckpointConfig *checkpoint, StreamResult *result);
+
+// Como run_stream, com o pool e as filas na arena de 'ctx' (ver SimContext)
+int run_stream_in(SimContext *ctx, Algorithm algorithm, ProcessSource *source, int quantum,
+                  const CheckpointConfig *checkpoint, StreamResult *result);
+
+void print_stream_result(const StreamResult *result);
+
+#endif
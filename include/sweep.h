@@ -0,0 +1,43 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "scheduler.h"
+
+// Intervalo de valores de um parâmetro: início:fim[:passo], com passo
+// aditivo ou multiplicativo ("x10")
+typedef struct {
+    double start;
+    double end;
+    double step;
+    bool geometric;
+    bool set;           // Parâmetro presente em --sweep
+} SweepRange;
+
+typedef struct {
+    Algorithm algorithm;
+    SweepRange quantum;     // Apenas RR
+    SweepRange processes;   // n
+    SweepRange lambda;      // Taxa de chegadas; ausente = chegadas da geração normal
+    long long horizon_cap;
+    uint64_t seed;
+    int threads;            // 0 = nº de CPUs
+    const char *output;     // Ficheiro CSV (NULL = stdout)
+} SweepConfig;
+
+// Interpreta "quantum=1:20,n=100:100000:x10,lambda=0.1:1:0.1" para config;
+// os parâmetros ausentes mantêm o valor único já presente em config.
+// Devolve -1 (com mensagem) se a especificação for inválida
+int parse_sweep(const char *spec, SweepConfig *config);
+
+// Fixa um parâmetro num único valor (usado para os valores por omissão)
+void sweep_range_single(SweepRange *range, double value);
+
+// Expande a grelha e simula cada ponto no conjunto de threads. Pontos com os
+// mesmos parâmetros de carga (n, lambda) partilham uma carga gerada uma vez.
+// Cada ponto produz uma linha CSV, escrita pela ordem da grelha assim que
+// os pontos anteriores estão concluídos. Devolve 0 em sucesso
+int run_sweep(const SweepConfig *config);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+
+// Flags no fim de um segmento de execução
+#define TRACE_DONE 0x1   // O processo/job terminou no fim do segmento
+#define TRACE_MISS 0x2   // Terminou depois do deadline
+
+// Segmento de execução codificado por comprimento: 'pid' ocupou a CPU em
+// [start, end). Intervalos sem segmentos são tempo ocioso.
+typedef struct {
+    int pid;
+    int start;
+    int end;
+    unsigned flags;
+} TraceSegment;
+
+// Traço de execução em memória, preenchido pelos motores de escalonamento
+// e desenhado pelos renderizadores de Gantt
+typedef struct {
+    TraceSegment *segments;
+    int count;
+    int capacity;
+    long long busy_time;    // Soma dos segmentos registados
+    long long dispatches;   // Segmentos pedidos pelo motor (decisões de escalonamento)
+    long long releases;     // Jobs libertados por RM/EDF (eventos sem segmento próprio)
+    bool keep_segments;     // false: só acumula busy_time
+} Trace;
+
+void trace_init(Trace *trace);
+
+// Traço que só contabiliza o tempo ocupado, sem guardar segmentos
+void trace_init_summary(Trace *trace);
+void trace_free(Trace *trace);
+void trace_reset(Trace *trace);
+
+// Acrescenta um segmento; é fundido com o anterior quando for o mesmo pid,
+// contíguo e o anterior não tiver terminado. Sem efeito se trace for NULL.
+void trace_add(Trace *trace, int pid, int start, int end, unsigned flags);
+
+#endif
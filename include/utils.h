@@ -2,15 +2,13 @@
 #define UTILS_H
 
 #include "process.h"
+#include "trace.h"
 
-void print_initial_state(Process *processes, int n);
+void print_initial_state(const ProcessTable *table);
 
-void print_non_preemptive(Process *processes, int n);
-void print_priority_preemptive(Process *processes, int n);
-void print_rr(Process *processes, int n, int quantum);
-void print_rm(Process *processes, int n);
-void print_edf(Process *processes, int n);
+// Desenha o diagrama de Gantt a partir do traço produzido pelo motor
+void print_gantt(const Trace *trace);
 
-void print_final_results(Process *processes, int n);
+void print_final_results(const ProcessTable *table);
 
 #endif
\ No newline at end of file
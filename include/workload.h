@@ -0,0 +1,44 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "process.h"
+
+// Formato binário de carga: cabeçalho seguido de uma coluna int32 por
+// atributo, pela ordem pid, chegada, burst, prioridade, deadline, período.
+// Cada coluna começa num múltiplo de WORKLOAD_ALIGN, pelo que o ficheiro
+// mapeado é usado diretamente como colunas de uma ProcessTable.
+#define WORKLOAD_MAGIC 0x4C575350u      // "PSWL"
+#define WORKLOAD_VERSION 1
+#define WORKLOAD_COLUMNS 6
+#define WORKLOAD_ALIGN 64
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t columns;
+    uint32_t reserved;
+    uint64_t count;                             // Número de processos
+    uint64_t column_offset[WORKLOAD_COLUMNS];   // Deslocamento de cada coluna
+} WorkloadHeader;
+
+// Carga mapeada em memória; as colunas de entrada da tabela apontam para o
+// ficheiro e só o estado e os resultados são alocados
+typedef struct {
+    ProcessTable table;
+    void *map;
+    size_t map_size;
+} MappedWorkload;
+
+// Mapeia o ficheiro e usa no máximo 'limit' processos (todos se limit <= 0).
+// Devolve 0 em sucesso, -1 em erro (mensagem já escrita).
+int workload_open(MappedWorkload *workload, const char *path, int limit);
+void workload_close(MappedWorkload *workload);
+
+// Converte um CSV (pid,chegada,burst,prioridade,deadline,período; cabeçalho
+// opcional; deadline e período podem ser omitidos) para o formato binário.
+// Devolve o número de processos escritos, ou -1 em erro.
+long long workload_convert_csv(const char *csv_path, const char *out_path);
+
+#endif
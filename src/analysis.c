@@ -0,0 +1,323 @@
+#include "analysis.h"
+#include "process.h"
+#include "ready_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+
+// As análises assumem libertação síncrona de todas as tarefas (instante
+// crítico), o que é o pior caso para tarefas com desfasamento inicial.
+
+static long long gcd_ll(long long a, long long b) {
+    while (b != 0) {
+        long long temp = b;
+        b = a % b;
+        a = temp;
+    }
+    return a;
+}
+
+long long hyperperiod(const ProcessTable *table, long long cap) {
+    int n = table->n;
+    long long h = 1;
+    for (int i = 0; i < n; i++) {
+        long long period = table->period[i];
+        if (period <= 0) continue;
+        long long a = h / gcd_ll(h, period);
+        if (a > cap / period) return -1;
+        h = a * period;
+    }
+    return h;
+}
+
+int simulation_horizon(const ProcessTable *table, long long cap, bool *truncated) {
+    int n = table->n;
+    // Margem para que next_release (release + período) não transborde em int
+    if (cap <= 0 || cap > INT_MAX / 2) cap = INT_MAX / 2;
+
+    bool has_periodic = false;
+    long long last_deadline = 0;
+    for (int i = 0; i < n; i++) {
+        if (table->period[i] > 0) {
+            has_periodic = true;
+        } else if (table->deadline[i] > last_deadline) {
+            last_deadline = table->deadline[i];
+        }
+    }
+
+    long long horizon = has_periodic ? hyperperiod(table, cap) : 100;
+    *truncated = false;
+    if (horizon < 0) {
+        horizon = cap;
+        *truncated = true;
+    }
+    if (last_deadline > horizon) horizon = last_deadline;
+    if (horizon > cap) {
+        horizon = cap;
+        *truncated = true;
+    }
+    return (int)horizon;
+}
+
+typedef struct {
+    int index;
+    long long C, T, D;
+} Task;
+
+// Tarefas periódicas do conjunto; devolve o número de tarefas (-1 em erro)
+static int collect_tasks(const ProcessTable *table, Task **out, double *utilization) {
+    int n = table->n;
+    Task *tasks = malloc((n > 0 ? n : 1) * sizeof(Task));
+    if (!tasks) return -1;
+
+    int m = 0;
+    *utilization = 0;
+    for (int i = 0; i < n; i++) {
+        if (table->period[i] <= 0) continue;
+        tasks[m].index = i;
+        tasks[m].C = table->burst_time[i];
+        tasks[m].T = table->period[i];
+        tasks[m].D = process_relative_deadline(table, i);
+        *utilization += (double)tasks[m].C / tasks[m].T;
+        m++;
+    }
+    *out = tasks;
+    return m;
+}
+
+static int sort_tasks_by_period(Task **tasks, int m) {
+    int *period = malloc((m > 0 ? m : 1) * sizeof(int));
+    int *order = malloc((m > 0 ? m : 1) * sizeof(int));
+    Task *sorted = malloc((m > 0 ? m : 1) * sizeof(Task));
+    if (!period || !order || !sorted) {
+        free(period);
+        free(order);
+        free(sorted);
+        return -1;
+    }
+    for (int k = 0; k < m; k++) {
+        period[k] = (int)(*tasks)[k].T;
+    }
+    int status = sort_index_by_key(period, m, order);
+    if (status == 0) {
+        for (int k = 0; k < m; k++) {
+            sorted[k] = (*tasks)[order[k]];
+        }
+        free(*tasks);
+        *tasks = sorted;
+    } else {
+        free(sorted);
+    }
+    free(period);
+    free(order);
+    return status;
+}
+
+SchedAnalysis analyze_rm(const ProcessTable *table, long long *response) {
+    int n = table->n;
+    SchedAnalysis result = { .schedulable = true, .failing_index = -1, .miss_time = -1 };
+    if (response) {
+        for (int i = 0; i < n; i++) response[i] = -1;
+    }
+
+    Task *tasks;
+    int m = collect_tasks(table, &tasks, &result.utilization);
+    if (m < 0) {
+        result.schedulable = false;
+        return result;
+    }
+    result.bound = (m > 0) ? m * (pow(2, 1.0 / m) - 1) : 1.0;
+
+    // Prioridade RM: menor período primeiro (empate pelo menor índice, pois
+    // as tarefas foram recolhidas por índice e a ordenação é estável)
+    if (sort_tasks_by_period(&tasks, m) != 0) {
+        free(tasks);
+        result.schedulable = false;
+        return result;
+    }
+
+    for (int k = 0; k < m; k++) {
+        // R = C_k + soma_{j<k} ceil(R / T_j) * C_j, iterado até ao ponto fixo
+        // ou até exceder o deadline
+        long long r = 0;
+        for (int j = 0; j <= k; j++) r += tasks[j].C;
+        while (r <= tasks[k].D) {
+            long long next = tasks[k].C;
+            for (int j = 0; j < k; j++) {
+                next += ((r + tasks[j].T - 1) / tasks[j].T) * tasks[j].C;
+            }
+            if (next == r) break;
+            r = next;
+        }
+
+        if (response) response[tasks[k].index] = r;
+        if (r > tasks[k].D && result.schedulable) {
+            result.schedulable = false;
+            result.failing_index = tasks[k].index;
+        }
+    }
+
+    free(tasks);
+    return result;
+}
+
+// Procura de processador h(t): trabalho com deadline absoluto <= t
+static long long demand(const Task *tasks, int m, long long t) {
+    long long h = 0;
+    for (int i = 0; i < m; i++) {
+        if (t >= tasks[i].D) {
+            h += ((t - tasks[i].D) / tasks[i].T + 1) * tasks[i].C;
+        }
+    }
+    return h;
+}
+
+// Maior deadline absoluto estritamente inferior a t (-1 se não houver)
+static long long deadline_before(const Task *tasks, int m, long long t) {
+    long long best = -1;
+    for (int i = 0; i < m; i++) {
+        if (t > tasks[i].D) {
+            long long d = ((t - tasks[i].D - 1) / tasks[i].T) * tasks[i].T + tasks[i].D;
+            if (d > best) best = d;
+        }
+    }
+    return best;
+}
+
+// Menor deadline absoluto estritamente superior a t
+static long long deadline_after(const Task *tasks, int m, long long t) {
+    long long best = LLONG_MAX;
+    for (int i = 0; i < m; i++) {
+        long long d = tasks[i].D;
+        if (t >= d) d += ((t - d) / tasks[i].T + 1) * tasks[i].T;
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+SchedAnalysis analyze_edf(const ProcessTable *table) {
+    SchedAnalysis result = { .schedulable = true, .failing_index = -1, .miss_time = -1 };
+
+    Task *tasks;
+    int m = collect_tasks(table, &tasks, &result.utilization);
+    if (m < 0) {
+        result.schedulable = false;
+        return result;
+    }
+    result.bound = 1.0;
+    if (m == 0) {
+        free(tasks);
+        return result;
+    }
+
+    if (result.utilization > 1.0 + 1e-9) {
+        result.schedulable = false;
+        free(tasks);
+        return result;
+    }
+
+    // Intervalo a verificar: mínimo entre o período ocupado síncrono (Lb) e,
+    // para U < 1, o limite La = max(D_max, soma (T_i - D_i) U_i / (1 - U))
+    long long busy = 0, d_min = LLONG_MAX, d_max = 0;
+    double slack = 0;
+    for (int i = 0; i < m; i++) {
+        busy += tasks[i].C;
+        if (tasks[i].D < d_min) d_min = tasks[i].D;
+        if (tasks[i].D > d_max) d_max = tasks[i].D;
+        slack += (double)(tasks[i].T - tasks[i].D) * tasks[i].C / tasks[i].T;
+    }
+    for (;;) {
+        long long next = 0;
+        for (int i = 0; i < m; i++) {
+            next += ((busy + tasks[i].T - 1) / tasks[i].T) * tasks[i].C;
+        }
+        if (next == busy || next > LLONG_MAX / 4) break;
+        busy = next;
+    }
+    long long limit = busy;
+    if (result.utilization < 1.0 - 1e-9) {
+        double la = slack / (1.0 - result.utilization);
+        long long bound_a = (la > d_max) ? (long long)ceil(la) : d_max;
+        if (bound_a < limit) limit = bound_a;
+    }
+
+    // QPA (Zhang & Burns): percorre os deadlines para trás a partir do limite,
+    // saltando diretamente para h(t) sempre que h(t) < t
+    long long t = deadline_before(tasks, m, limit + 1);
+    long long h = (t >= 0) ? demand(tasks, m, t) : 0;
+    while (t >= 0 && h <= t && h > d_min) {
+        t = (h < t) ? h : deadline_before(tasks, m, t);
+        if (t >= 0) h = demand(tasks, m, t);
+    }
+
+    if (t >= 0 && h > t) {
+        // h só muda nos deadlines, pelo que o último deadline <= t viola; o
+        // QPA não garante que seja o primeiro, procurado para a frente a
+        // partir de d_min
+        long long last = deadline_before(tasks, m, t + 1);
+        long long d = d_min;
+        while (d < last && demand(tasks, m, d) <= d) {
+            d = deadline_after(tasks, m, d);
+        }
+        result.schedulable = false;
+        result.miss_time = d;
+        for (int i = 0; i < m; i++) {
+            if (d >= tasks[i].D && (d - tasks[i].D) % tasks[i].T == 0) {
+                result.failing_index = tasks[i].index;
+                break;
+            }
+        }
+    }
+
+    free(tasks);
+    return result;
+}
+
+void print_rm_analysis(const ProcessTable *table) {
+    int n = table->n;
+    long long *response = malloc((n > 0 ? n : 1) * sizeof(long long));
+    if (!response) {
+        perror("Erro ao alocar memória para a análise");
+        return;
+    }
+    SchedAnalysis result = analyze_rm(table, response);
+
+    printf("\n=== Análise de Escalonabilidade (Rate Monotonic, RTA) ===\n\n");
+    printf("Utilização: %.2f, Limite de Liu-Layland: %.2f\n\n", result.utilization, result.bound);
+    printf("%-5s %-8s %-6s %-9s %-9s %-6s\n", "PID", "Período", "Burst", "Deadline", "Resposta", "Estado");
+    printf("-----------------------------------------------\n");
+    for (int i = 0; i < n; i++) {
+        if (table->period[i] <= 0) continue;
+        int deadline = process_relative_deadline(table, i);
+        printf("%-5d %-8d %-6d %-9d %-9lld %-6s\n",
+               table->pid[i], table->period[i], table->burst_time[i],
+               deadline, response[i], response[i] <= deadline ? "OK" : "FALHA");
+    }
+
+    if (result.schedulable) {
+        printf("\nResultado: escalonável\n");
+    } else if (result.failing_index >= 0) {
+        printf("\nResultado: NÃO escalonável (primeira falha: P%d)\n",
+               table->pid[result.failing_index]);
+    } else {
+        printf("\nResultado: NÃO escalonável\n");
+    }
+    free(response);
+}
+
+void print_edf_analysis(const ProcessTable *table) {
+    SchedAnalysis result = analyze_edf(table);
+
+    printf("\n=== Análise de Escalonabilidade (EDF, procura de processador/QPA) ===\n\n");
+    printf("Utilização: %.2f\n", result.utilization);
+
+    if (result.schedulable) {
+        printf("\nResultado: escalonável\n");
+    } else if (result.miss_time >= 0 && result.failing_index >= 0) {
+        printf("\nResultado: NÃO escalonável (procura excede o tempo em t=%lld, P%d)\n",
+               result.miss_time, table->pid[result.failing_index]);
+    } else {
+        printf("\nResultado: NÃO escalonável (utilização > 1)\n");
+    }
+}
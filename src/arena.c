@@ -0,0 +1,76 @@
+#include "arena.h"
+#include <stdalign.h>
+#include <stdlib.h>
+
+#define ARENA_ALIGNMENT alignof(max_align_t)
+
+// Bloco inicial: cargas pequenas cabem todas num só
+#define ARENA_MIN_BLOCK (64 * 1024)
+
+struct ArenaBlock {
+    ArenaBlock *previous;
+    size_t capacity;
+    size_t offset;
+    alignas(max_align_t) unsigned char data[];
+};
+
+static ArenaBlock *new_block(size_t capacity, ArenaBlock *previous) {
+    if (capacity < ARENA_MIN_BLOCK) capacity = ARENA_MIN_BLOCK;
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + capacity);
+    if (!block) return NULL;
+    block->previous = previous;
+    block->capacity = capacity;
+    block->offset = 0;
+    return block;
+}
+
+static void free_blocks(ArenaBlock *block) {
+    while (block) {
+        ArenaBlock *previous = block->previous;
+        free(block);
+        block = previous;
+    }
+}
+
+void arena_init(Arena *arena) {
+    arena->current = NULL;
+    arena->used = 0;
+    arena->peak = 0;
+}
+
+void arena_free(Arena *arena) {
+    free_blocks(arena->current);
+    arena_init(arena);
+}
+
+void arena_reset(Arena *arena) {
+    ArenaBlock *block = arena->current;
+    if (block && block->previous) {
+        // Vários blocos: são trocados por um só com o pico e uma folga de 1/8
+        // para execuções de tamanho semelhante (se faltar memória, volta a
+        // ser criado a pedido)
+        free_blocks(block);
+        arena->current = new_block(arena->peak + arena->peak / 8, NULL);
+    } else if (block) {
+        block->offset = 0;
+    }
+    arena->used = 0;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+    size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    ArenaBlock *block = arena->current;
+    if (!block || block->capacity - block->offset < size) {
+        // Cada bloco novo tem pelo menos o dobro do anterior
+        size_t capacity = block ? 2 * block->capacity : 0;
+        if (capacity < size) capacity = size;
+        block = new_block(capacity, block);
+        if (!block) return NULL;
+        arena->current = block;
+    }
+    void *data = block->data + block->offset;
+    block->offset += size;
+    arena->used += size;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return data;
+}
@@ -0,0 +1,313 @@
+// Benchmark dos motores de escalonamento: cada caso (algoritmo, tamanho)
+// corre num processo filho, para que o pico de RSS e as alocações sejam só
+// desse caso. Resultados legíveis no terminal e em CSV para comparar versões.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "process.h"
+#include "scheduler.h"
+#include "analysis.h"
+#include "trace.h"
+#include "distributions.h"
+#include "rng.h"
+
+// Contagem de alocações: o binário é ligado com -Wl,--wrap=malloc,...
+static atomic_llong allocation_count;
+static atomic_llong allocated_bytes;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+static void count_allocation(size_t size) {
+    atomic_fetch_add_explicit(&allocation_count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&allocated_bytes, (long long)size, memory_order_relaxed);
+}
+
+void *__wrap_malloc(size_t size) {
+    count_allocation(size);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    count_allocation(count * size);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    count_allocation(size);
+    return __real_realloc(ptr, size);
+}
+
+typedef struct {
+    int min_processes;
+    int max_processes;
+    int max_real_time;      // RM/EDF crescem com o horizonte; limite próprio
+    int quantum;
+    long long horizon_cap;
+    uint64_t seed;
+    int only;               // Algoritmo a medir (-1 = todos)
+    long long samples;      // Amostras por distribuição no micro-benchmark (0 = omite)
+    const char *output;
+    const char *label;
+} BenchOptions;
+
+// Medições de um caso, enviadas do filho para o pai por um pipe
+typedef struct {
+    double generation_seconds;
+    double simulation_seconds;
+    long long decisions;
+    long long peak_rss_kb;
+    long long allocations;
+    long long bytes;
+    bool ok;
+} BenchResult;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run_case(Algorithm algorithm, int n, const BenchOptions *options, BenchResult *result) {
+    memset(result, 0, sizeof(*result));
+    bool real_time = algorithm_is_real_time(algorithm);
+
+    double start = now_seconds();
+    ProcessTable table;
+    if (process_table_init(&table, n) != 0) return;
+    generate_processes(&table, real_time, options->seed);
+    int horizon = 0;
+    if (real_time) {
+        bool truncated;
+        horizon = simulation_horizon(&table, options->horizon_cap, &truncated);
+    }
+    result->generation_seconds = now_seconds() - start;
+
+    // Só o motor conta para o tempo de simulação e para as alocações
+    Trace usage;
+    trace_init_summary(&usage);
+    atomic_store(&allocation_count, 0);
+    atomic_store(&allocated_bytes, 0);
+    start = now_seconds();
+    bool ran = run_algorithm(algorithm, &table, options->quantum, horizon, &usage) == 0;
+    result->simulation_seconds = now_seconds() - start;
+    result->allocations = atomic_load(&allocation_count);
+    result->bytes = atomic_load(&allocated_bytes);
+    // Em RM/EDF cada libertação de job também é um evento processado pelo
+    // motor, mesmo quando não dá origem a um novo segmento
+    result->decisions = usage.dispatches + usage.releases;
+
+    struct rusage usage_self;
+    getrusage(RUSAGE_SELF, &usage_self);
+    result->peak_rss_kb = usage_self.ru_maxrss;
+    result->ok = ran;
+    process_table_free(&table);
+}
+
+// Débito dos amostradores em lote, em blocos que cabem na cache
+#define SAMPLER_BLOCK 4096
+
+typedef enum { SAMPLER_POISSON_SMALL, SAMPLER_POISSON_LARGE, SAMPLER_EXPONENTIAL,
+               SAMPLER_NORMAL, SAMPLER_UNIFORM, SAMPLER_COUNT } Sampler;
+
+static const char *sampler_names[SAMPLER_COUNT] = {
+    "Poisson(5)", "Poisson(100)", "Exponencial", "Normal(5,3)", "Uniforme[1,10]"
+};
+
+static void run_samplers(const BenchOptions *options) {
+    static int ints[SAMPLER_BLOCK];
+    static double doubles[SAMPLER_BLOCK];
+
+    printf("%-16s %12s %10s\n", "Amostrador", "Amostras", "M/s");
+    printf("----------------------------------------\n");
+    for (int s = 0; s < SAMPLER_COUNT; s++) {
+        Rng rng;
+        rng_init(&rng, options->seed, (uint64_t)s);
+        long long checksum = 0;
+        double start = now_seconds();
+        for (long long done = 0; done < options->samples; done += SAMPLER_BLOCK) {
+            int count = options->samples - done < SAMPLER_BLOCK
+                ? (int)(options->samples - done) : SAMPLER_BLOCK;
+            switch ((Sampler)s) {
+                case SAMPLER_POISSON_SMALL: poisson_fill(&rng, 5.0, ints, count); break;
+                case SAMPLER_POISSON_LARGE: poisson_fill(&rng, 100.0, ints, count); break;
+                case SAMPLER_EXPONENTIAL:   exponential_fill(&rng, 0.2, doubles, count); break;
+                case SAMPLER_NORMAL:        normal_fill(&rng, 5, 3, ints, count); break;
+                case SAMPLER_UNIFORM:       uniform_fill(&rng, 1, 10, ints, count); break;
+                default: break;
+            }
+            // Impede que o compilador descarte os lotes
+            checksum += (s == SAMPLER_EXPONENTIAL) ? (long long)doubles[count - 1] : ints[count - 1];
+        }
+        double seconds = now_seconds() - start;
+        printf("%-16s %12lld %10.1f\n", sampler_names[s], options->samples,
+               seconds > 0 ? options->samples / seconds / 1e6 : 0.0);
+        if (checksum == -1) printf("\n");
+    }
+    printf("\n");
+}
+
+// Executa o caso num filho e recolhe as medições
+static bool measure_case(Algorithm algorithm, int n, const BenchOptions *options,
+                         BenchResult *result) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return false;
+    }
+    fflush(stdout);
+    pid_t child = fork();
+    if (child < 0) {
+        perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (child == 0) {
+        close(fds[0]);
+        BenchResult measured;
+        run_case(algorithm, n, options, &measured);
+        ssize_t written = write(fds[1], &measured, sizeof(measured));
+        close(fds[1]);
+        _exit(written == (ssize_t)sizeof(measured) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], result, sizeof(*result));
+    close(fds[0]);
+    int status;
+    waitpid(child, &status, 0);
+    return got == (ssize_t)sizeof(*result) && WIFEXITED(status) &&
+           WEXITSTATUS(status) == 0 && result->ok;
+}
+
+static void print_usage(const char *program_name) {
+    printf("Uso: %s [opções]\n", program_name);
+    printf("  --min N         - menor carga (omissão: 1000)\n");
+    printf("  --max N         - maior carga (omissão: 10000000)\n");
+    printf("  --max-rt N      - maior carga para RM/EDF (omissão: 100000)\n");
+    printf("  --horizon H     - limite do horizonte RM/EDF (omissão: 1000)\n");
+    printf("  --quantum Q     - quantum de RR (omissão: 4)\n");
+    printf("  --seed S        - semente das cargas (omissão: 1)\n");
+    printf("  --only ALG      - mede apenas um algoritmo\n");
+    printf("  --samplers N    - amostras por distribuição no micro-benchmark (omissão: 10000000, 0 omite)\n");
+    printf("  --output F      - ficheiro CSV de resultados (omissão: bench.csv)\n");
+    printf("  --label L       - etiqueta da versão medida, guardada no CSV\n");
+}
+
+static int parse_bench_options(int argc, char *argv[], BenchOptions *options) {
+    options->min_processes = 1000;
+    options->max_processes = 10000000;
+    options->max_real_time = 100000;
+    options->quantum = 4;
+    options->horizon_cap = 1000;
+    options->seed = 1;
+    options->only = -1;
+    options->samples = 10000000;
+    options->output = "bench.csv";
+    options->label = "local";
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--min") == 0 && has_value) {
+            options->min_processes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max") == 0 && has_value) {
+            options->max_processes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-rt") == 0 && has_value) {
+            options->max_real_time = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--horizon") == 0 && has_value) {
+            options->horizon_cap = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--quantum") == 0 && has_value) {
+            options->quantum = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            options->seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--only") == 0 && has_value) {
+            options->only = parse_algorithm(argv[++i]);
+            if (options->only < 0) {
+                printf("Algoritmo desconhecido: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--samplers") == 0 && has_value) {
+            options->samples = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && has_value) {
+            options->output = argv[++i];
+        } else if (strcmp(argv[i], "--label") == 0 && has_value) {
+            options->label = argv[++i];
+        } else {
+            printf("Opção inválida: %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if (options->min_processes < 1 || options->quantum < 1 || options->samples < 0) {
+        printf("Erro: --min e --quantum têm de ser positivos e --samplers não negativo\n");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    if (parse_bench_options(argc, argv, &options) != 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (options.samples > 0) run_samplers(&options);
+
+    FILE *csv = fopen(options.output, "w");
+    if (!csv) {
+        perror(options.output);
+        return 1;
+    }
+    fprintf(csv, "label,algorithm,processes,seed,generation_s,simulation_s,decisions,"
+                 "ns_per_decision,peak_rss_kb,allocations,allocated_bytes,"
+                 "generated_per_s\n");
+
+    printf("%-12s %10s %9s %10s %9s %11s %10s %9s %9s %12s\n", "Algoritmo", "Processos",
+           "Geração", "Proc/s", "Simulação", "Decisões", "ns/decisão", "RSS (MB)", "Alocações",
+           "Bytes");
+    printf("-----------------------------------------------------------------------------------------------------------\n");
+
+    int failures = 0;
+    for (int a = 0; a < ALG_COUNT; a++) {
+        if (options.only >= 0 && a != options.only) continue;
+        Algorithm algorithm = (Algorithm)a;
+        int max = algorithm_is_real_time(algorithm) ? options.max_real_time : options.max_processes;
+
+        for (long long n = options.min_processes; n <= max; n *= 10) {
+            BenchResult result;
+            if (!measure_case(algorithm, (int)n, &options, &result)) {
+                printf("%-12s %10lld falhou\n", algorithm_name(algorithm), n);
+                failures++;
+                continue;
+            }
+
+            double ns_per_decision = result.decisions > 0
+                ? result.simulation_seconds * 1e9 / result.decisions : 0.0;
+            double generated_per_s = result.generation_seconds > 0
+                ? n / result.generation_seconds : 0.0;
+            printf("%-12s %10lld %8.3fs %10.3g %8.3fs %11lld %10.1f %9.1f %9lld %12lld\n",
+                   algorithm_name(algorithm), n, result.generation_seconds, generated_per_s,
+                   result.simulation_seconds, result.decisions, ns_per_decision,
+                   result.peak_rss_kb / 1024.0, result.allocations, result.bytes);
+            fprintf(csv, "%s,%s,%lld,%llu,%.6f,%.6f,%lld,%.2f,%lld,%lld,%lld,%.0f\n",
+                    options.label, algorithm_name(algorithm), n,
+                    (unsigned long long)options.seed, result.generation_seconds,
+                    result.simulation_seconds, result.decisions, ns_per_decision,
+                    result.peak_rss_kb, result.allocations, result.bytes, generated_per_s);
+            fflush(csv);
+        }
+    }
+
+    fclose(csv);
+    printf("\nResultados escritos em %s\n", options.output);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+#include "checkpoint.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+uint64_t checkpoint_fingerprint(const ProcessTable *table) {
+    const int *columns[] = {
+        table->pid, table->arrival_time, table->burst_time,
+        table->priority, table->deadline, table->period
+    };
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t c = 0; c < sizeof(columns) / sizeof(columns[0]); c++) {
+        for (int i = 0; i < table->n; i++) {
+            uint32_t value = (uint32_t)columns[c][i];
+            for (int b = 0; b < 4; b++) {
+                hash ^= (value >> (8 * b)) & 0xFF;
+                hash *= 0x100000001b3ULL;
+            }
+        }
+    }
+    return hash;
+}
+
+int checkpoint_next_time(const CheckpointConfig *config, int time) {
+    long long next = ((long long)time / config->interval + 1) * config->interval;
+    return next > INT32_MAX ? INT32_MAX : (int)next;
+}
+
+int checkpoint_writer_open(CheckpointWriter *w, const char *path, const CheckpointHeader *header) {
+    memset(w, 0, sizeof(*w));
+    w->path = path;
+    w->temp_path = malloc(strlen(path) + 5);
+    if (!w->temp_path) {
+        perror("Erro ao gravar checkpoint");
+        return -1;
+    }
+    sprintf(w->temp_path, "%s.tmp", path);
+    w->file = fopen(w->temp_path, "wb");
+    if (!w->file) {
+        perror(w->temp_path);
+        free(w->temp_path);
+        w->temp_path = NULL;
+        return -1;
+    }
+    checkpoint_write(w, header, sizeof(*header));
+    return 0;
+}
+
+void checkpoint_write(CheckpointWriter *w, const void *data, size_t size) {
+    if (!w->failed && size > 0 && fwrite(data, 1, size, w->file) != size) {
+        w->failed = true;
+    }
+}
+
+void checkpoint_write_int(CheckpointWriter *w, int value) {
+    checkpoint_write(w, &value, sizeof(value));
+}
+
+void checkpoint_write_ints(CheckpointWriter *w, const int *values, int count) {
+    checkpoint_write_int(w, count);
+    checkpoint_write(w, values, (size_t)count * sizeof(int));
+}
+
+void checkpoint_write_queue(CheckpointWriter *w, const ReadyQueue *q) {
+    checkpoint_write_int(w, q->size);
+    for (int i = 0; i < q->size; i++) {
+        checkpoint_write_int(w, q->heap[i]);
+        checkpoint_write_int(w, q->key[q->heap[i]]);
+    }
+}
+
+void checkpoint_write_fifo(CheckpointWriter *w, const FifoQueue *q) {
+    checkpoint_write_int(w, q->size);
+    for (int i = 0; i < q->size; i++) {
+        checkpoint_write_int(w, q->items[(q->head + i) % q->capacity]);
+    }
+}
+
+int checkpoint_writer_close(CheckpointWriter *w) {
+    // Os dados têm de estar no disco antes de substituírem o checkpoint anterior
+    bool ok = !w->failed && fflush(w->file) == 0 && fsync(fileno(w->file)) == 0;
+    ok = (fclose(w->file) == 0) && ok;
+    ok = ok && rename(w->temp_path, w->path) == 0;
+    if (!ok) {
+        perror(w->path);
+        remove(w->temp_path);
+    }
+    free(w->temp_path);
+    memset(w, 0, sizeof(*w));
+    return ok ? 0 : -1;
+}
+
+int checkpoint_reader_open(CheckpointReader *r, const char *path, const CheckpointHeader *expected) {
+    memset(r, 0, sizeof(*r));
+    r->path = path;
+    r->file = fopen(path, "rb");
+    if (!r->file) {
+        perror(path);
+        return -1;
+    }
+
+    CheckpointHeader header;
+    if (fread(&header, sizeof(header), 1, r->file) != 1 ||
+        header.magic != CHECKPOINT_MAGIC || header.version != CHECKPOINT_VERSION) {
+        printf("Erro: %s não é um checkpoint válido\n", path);
+        fclose(r->file);
+        return -1;
+    }
+    if (header.kind != expected->kind || header.algorithm != expected->algorithm ||
+        header.n != expected->n || header.parameter != expected->parameter ||
+        header.fingerprint != expected->fingerprint || header.flags != expected->flags) {
+        printf("Erro: o checkpoint %s foi gravado com outro algoritmo, parâmetros ou carga\n",
+               path);
+        fclose(r->file);
+        return -1;
+    }
+    return header.time;
+}
+
+void checkpoint_read(CheckpointReader *r, void *data, size_t size) {
+    if (r->failed || size == 0) return;
+    if (fread(data, 1, size, r->file) != size) {
+        r->failed = true;
+        memset(data, 0, size);
+    }
+}
+
+int checkpoint_read_int(CheckpointReader *r) {
+    int value = 0;
+    checkpoint_read(r, &value, sizeof(value));
+    return value;
+}
+
+void checkpoint_read_ints(CheckpointReader *r, int *values, int count) {
+    if (checkpoint_read_int(r) != count) {
+        r->failed = true;
+        return;
+    }
+    checkpoint_read(r, values, (size_t)count * sizeof(int));
+}
+
+void checkpoint_read_queue(CheckpointReader *r, ReadyQueue *q) {
+    ready_queue_clear(q);
+    int size = checkpoint_read_int(r);
+    if (size < 0 || size > q->capacity) {
+        r->failed = true;
+        return;
+    }
+    for (int i = 0; i < size && !r->failed; i++) {
+        int id = checkpoint_read_int(r);
+        int key = checkpoint_read_int(r);
+        if (id < 0 || id >= q->capacity || q->pos[id] >= 0) {
+            r->failed = true;
+            break;
+        }
+        q->heap[i] = id;
+        q->key[id] = key;
+        q->pos[id] = i;
+        q->size = i + 1;
+    }
+}
+
+void checkpoint_read_fifo(CheckpointReader *r, FifoQueue *q) {
+    q->head = q->size = 0;
+    int size = checkpoint_read_int(r);
+    if (size < 0 || size > q->capacity) {
+        r->failed = true;
+        return;
+    }
+    for (int i = 0; i < size && !r->failed; i++) {
+        if (fifo_queue_push(q, checkpoint_read_int(r)) != 0) r->failed = true;
+    }
+}
+
+int checkpoint_reader_close(CheckpointReader *r) {
+    bool ok = !r->failed && fgetc(r->file) == EOF;
+    fclose(r->file);
+    if (!ok) {
+        printf("Erro: o checkpoint %s está corrompido ou não corresponde a esta execução\n",
+               r->path);
+    }
+    memset(r, 0, sizeof(*r));
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,84 @@
+#include "compare.h"
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    const ProcessTable *workload;
+    const CompareConfig *config;
+    CompareResult *results;
+    SimContext *contexts;   // Um por worker, reutilizado entre algoritmos
+} CompareJob;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run_compared_algorithm(int index, int worker, void *arg) {
+    CompareJob *job = (CompareJob *)arg;
+    CompareResult *result = &job->results[index];
+
+    result->algorithm = (Algorithm)index;
+    result->ok = false;
+
+    ProcessTable view;
+    if (process_table_init_view(&view, job->workload) != 0) return;
+
+    int horizon = algorithm_is_real_time(result->algorithm) ? job->config->horizon : 0;
+    Trace usage;
+    trace_init_summary(&usage);
+    double start = now_seconds();
+    if (run_algorithm_in(&job->contexts[worker], result->algorithm, &view, job->config->quantum,
+                         horizon, &usage) != 0) {
+        process_table_free(&view);
+        return;
+    }
+    result->seconds = now_seconds() - start;
+
+    result->stats = algorithm_stats(result->algorithm, &view, horizon, &usage.busy_time, 1);
+    result->ok = calculate_percentiles(&view, &result->stats) == 0;
+    process_table_free(&view);
+}
+
+void run_comparison(const ProcessTable *workload, const CompareConfig *config,
+                    CompareResult *results) {
+    int threads = (config->threads > 0) ? config->threads : default_thread_count();
+    CompareJob job = { workload, config, results, calloc(threads, sizeof(SimContext)) };
+    if (!job.contexts) {
+        for (int a = 0; a < ALG_COUNT; a++) {
+            results[a].algorithm = (Algorithm)a;
+            results[a].ok = false;
+        }
+        return;
+    }
+    for (int t = 0; t < threads; t++) {
+        sim_context_init(&job.contexts[t]);
+    }
+    parallel_for(ALG_COUNT, threads, run_compared_algorithm, &job);
+    for (int t = 0; t < threads; t++) {
+        sim_context_free(&job.contexts[t]);
+    }
+    free(job.contexts);
+}
+
+void print_comparison(const CompareResult *results, int count) {
+    printf("\n=== Comparação dos Algoritmos ===\n\n");
+    printf("%-12s %12s %12s %12s %12s %11s %10s %10s\n", "Algoritmo", "Espera", "Espera p99",
+           "Turnaround", "Utilização", "Throughput", "Deadlines", "Tempo (s)");
+    printf("--------------------------------------------------------------------------------------------------\n");
+    for (int a = 0; a < count; a++) {
+        const CompareResult *r = &results[a];
+        if (!r->ok) {
+            printf("%-12s falhou (memória insuficiente)\n", algorithm_name(r->algorithm));
+            continue;
+        }
+        printf("%-12s %12.2f %12d %12.2f %10.2f%% %11.4f %10d %10.4f\n",
+               algorithm_name(r->algorithm), r->stats.avg_waiting_time,
+               r->stats.waiting_percentiles.p99, r->stats.avg_turnaround_time,
+               r->stats.cpu_utilization,
+               r->stats.throughput, r->stats.deadline_misses, r->seconds);
+    }
+}
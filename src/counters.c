@@ -0,0 +1,72 @@
+#include "counters.h"
+
+#ifdef PROBSCHED_COUNTERS
+
+#include <time.h>
+
+_Thread_local SimCounters sim_counters;
+
+// Tempos por fase, medidos apenas pela thread principal
+static double phase_seconds[PHASE_COUNT];
+static double phase_started[PHASE_COUNT];
+
+static const char *const phase_names[PHASE_COUNT] = {
+    "generation", "simulation", "rendering", "stats"
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void counters_phase_begin(Phase phase) {
+    phase_started[phase] = now_seconds();
+}
+
+void counters_phase_end(Phase phase) {
+    phase_seconds[phase] += now_seconds() - phase_started[phase];
+}
+
+void counters_merge(SimCounters *into, const SimCounters *from) {
+    into->decisions += from->decisions;
+    into->context_switches += from->context_switches;
+    into->preemptions += from->preemptions;
+    into->idle_jumps += from->idle_jumps;
+    into->idle_time += from->idle_time;
+    into->releases += from->releases;
+    into->queue_operations += from->queue_operations;
+    into->sift_steps += from->sift_steps;
+}
+
+void counters_delta(SimCounters *out, const SimCounters *after, const SimCounters *before) {
+    out->decisions = after->decisions - before->decisions;
+    out->context_switches = after->context_switches - before->context_switches;
+    out->preemptions = after->preemptions - before->preemptions;
+    out->idle_jumps = after->idle_jumps - before->idle_jumps;
+    out->idle_time = after->idle_time - before->idle_time;
+    out->releases = after->releases - before->releases;
+    out->queue_operations = after->queue_operations - before->queue_operations;
+    out->sift_steps = after->sift_steps - before->sift_steps;
+}
+
+void counters_dump_json(FILE *out) {
+    const SimCounters *c = &sim_counters;
+    fprintf(out, "{\n  \"counters\": {\n");
+    fprintf(out, "    \"decisions\": %lld,\n", c->decisions);
+    fprintf(out, "    \"context_switches\": %lld,\n", c->context_switches);
+    fprintf(out, "    \"preemptions\": %lld,\n", c->preemptions);
+    fprintf(out, "    \"idle_jumps\": %lld,\n", c->idle_jumps);
+    fprintf(out, "    \"idle_time\": %lld,\n", c->idle_time);
+    fprintf(out, "    \"releases\": %lld,\n", c->releases);
+    fprintf(out, "    \"queue_operations\": %lld,\n", c->queue_operations);
+    fprintf(out, "    \"sift_steps\": %lld\n", c->sift_steps);
+    fprintf(out, "  },\n  \"phases_seconds\": {\n");
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        fprintf(out, "    \"%s\": %.6f%s\n", phase_names[p], phase_seconds[p],
+                p + 1 < PHASE_COUNT ? "," : "");
+    }
+    fprintf(out, "  }\n}\n");
+}
+
+#endif
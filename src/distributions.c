@@ -1,46 +1,262 @@
 #include "distributions.h"
+#include "rng.h"
 #include <math.h>
-#include <stdlib.h>
-#include <time.h>
+#include <stdbool.h>
+#include <pthread.h>
 
-static int initialized = 0;
+// Uniforme em (0, 1) a partir de 53 bits já gerados
+static inline double unit_from_bits(uint64_t bits53) {
+    return ((double)bits53 + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// Tabelas do ziggurat (Doornik, "An Improved Ziggurat Method to Generate
+// Normal Random Samples", 2005; Marsaglia e Tsang, 2000). x[i] é o limite
+// direito da camada i, todas com a mesma área; ratio[i] = x[i+1] / x[i] é a
+// fração da camada inteiramente sob a curva
+#define ZIG_NORMAL_LAYERS 128
+#define ZIG_NORMAL_R 3.442619855899
+#define ZIG_NORMAL_V 9.91256303526217e-3
+
+#define ZIG_EXP_LAYERS 256
+#define ZIG_EXP_R 7.69711747013104972
+#define ZIG_EXP_V 3.949659822581572e-3
+
+static double normal_x[ZIG_NORMAL_LAYERS + 1];
+static double normal_ratio[ZIG_NORMAL_LAYERS];
+static double exp_x[ZIG_EXP_LAYERS + 1];
+static double exp_f[ZIG_EXP_LAYERS + 1];
+static double exp_ratio[ZIG_EXP_LAYERS];
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+
+static void init_tables(void) {
+    double f = exp(-0.5 * ZIG_NORMAL_R * ZIG_NORMAL_R);
+    normal_x[0] = ZIG_NORMAL_V / f;
+    normal_x[1] = ZIG_NORMAL_R;
+    normal_x[ZIG_NORMAL_LAYERS] = 0;
+    for (int i = 2; i < ZIG_NORMAL_LAYERS; i++) {
+        normal_x[i] = sqrt(-2.0 * log(ZIG_NORMAL_V / normal_x[i - 1] + f));
+        f = exp(-0.5 * normal_x[i] * normal_x[i]);
+    }
+    for (int i = 0; i < ZIG_NORMAL_LAYERS; i++) {
+        normal_ratio[i] = normal_x[i + 1] / normal_x[i];
+    }
 
-void init_random() {
-    if (!initialized) {
-        srand(time(NULL));
-        initialized = 1;
+    f = exp(-ZIG_EXP_R);
+    exp_x[0] = ZIG_EXP_V / f;
+    exp_x[1] = ZIG_EXP_R;
+    exp_x[ZIG_EXP_LAYERS] = 0;
+    for (int i = 2; i < ZIG_EXP_LAYERS; i++) {
+        exp_x[i] = -log(ZIG_EXP_V / exp_x[i - 1] + f);
+        f = exp(-exp_x[i]);
+    }
+    for (int i = 0; i <= ZIG_EXP_LAYERS; i++) {
+        exp_f[i] = exp(-exp_x[i]);
+    }
+    for (int i = 0; i < ZIG_EXP_LAYERS; i++) {
+        exp_ratio[i] = exp_x[i + 1] / exp_x[i];
     }
 }
 
-int poisson_distribution(double lambda) {
-    init_random();
-    double L = exp(-lambda);
-    double p = 1.0;
-    int k = 0;
-    
+// Cauda da normal para |x| > R (Marsaglia, 1964)
+static double normal_tail(Rng *rng, bool negative) {
+    double x, y;
     do {
-        k++;
-        p *= (double)rand() / RAND_MAX;
-    } while (p > L);
-    
-    return k - 1;
+        x = log(rng_uniform(rng)) / ZIG_NORMAL_R;
+        y = log(rng_uniform(rng));
+    } while (-2.0 * y < x * x);
+    return negative ? x - ZIG_NORMAL_R : ZIG_NORMAL_R - x;
+}
+
+static double sample_standard_normal(Rng *rng) {
+    for (;;) {
+        // 7 bits escolhem a camada e os 53 de cima a posição nela
+        uint64_t bits = rng_next_u64(rng);
+        int i = bits & (ZIG_NORMAL_LAYERS - 1);
+        double u = 2.0 * unit_from_bits(bits >> 11) - 1.0;
+        if (fabs(u) < normal_ratio[i]) return u * normal_x[i];
+        if (i == 0) return normal_tail(rng, u < 0);
+
+        // Cunha entre o retângulo interior e a curva
+        double x = u * normal_x[i];
+        double f0 = exp(-0.5 * (normal_x[i] * normal_x[i] - x * x));
+        double f1 = exp(-0.5 * (normal_x[i + 1] * normal_x[i + 1] - x * x));
+        if (f1 + rng_uniform(rng) * (f0 - f1) < 1.0) return x;
+    }
+}
+
+static double sample_standard_exponential(Rng *rng) {
+    for (;;) {
+        uint64_t bits = rng_next_u64(rng);
+        int i = bits & (ZIG_EXP_LAYERS - 1);
+        double u = unit_from_bits(bits >> 11);
+        if (u < exp_ratio[i]) return u * exp_x[i];
+
+        // Cauda sem memória: R mais uma nova exponencial
+        if (i == 0) return ZIG_EXP_R - log(rng_uniform(rng));
+
+        double x = u * exp_x[i];
+        if (exp_f[i] + rng_uniform(rng) * (exp_f[i + 1] - exp_f[i]) < exp(-x)) return x;
+    }
+}
+
+double standard_normal(Rng *rng) {
+    pthread_once(&tables_once, init_tables);
+    return sample_standard_normal(rng);
+}
+
+// log(x!) para a rejeição de PTRS: série de Stirling, com recorrência para
+// argumentos pequenos (lgamma não é reentrante)
+static double log_factorial(long k) {
+    static const double coefficients[10] = {
+        8.333333333333333e-02, -2.777777777777778e-03, 7.936507936507937e-04,
+        -5.952380952380952e-04, 8.417508417508418e-04, -1.917526917526918e-03,
+        6.410256410256410e-03, -2.955065359477124e-02, 1.796443723688307e-01,
+        -1.39243221690590e+00
+    };
+    double x = (double)k + 1.0;
+    if (k <= 1) return 0.0;
+
+    long shift = 0;
+    double x0 = x;
+    if (x <= 7) {
+        shift = (long)(7 - x);
+        x0 = x + shift;
+    }
+    double inverse_square = 1.0 / (x0 * x0);
+    double series = coefficients[9];
+    for (int c = 8; c >= 0; c--) {
+        series = series * inverse_square + coefficients[c];
+    }
+    double result = series / x0 + 0.5 * log(2.0 * M_PI) + (x0 - 0.5) * log(x0) - x0;
+    for (long s = 0; s < shift; s++) {
+        x0 -= 1.0;
+        result -= log(x0);
+    }
+    return result;
+}
+
+// Constantes de Poisson dependentes só de lambda, calculadas uma vez por lote
+typedef struct {
+    double lambda;
+    double exp_neg_lambda;  // Inversão
+    double log_lambda;      // PTRS
+    double a, b;
+    double log_inverse_alpha;
+    double v_r;
+} PoissonParams;
+
+static void poisson_setup(PoissonParams *p, double lambda) {
+    p->lambda = lambda;
+    if (lambda < POISSON_PTRS_MIN) {
+        p->exp_neg_lambda = exp(-lambda);
+        return;
+    }
+    double root = sqrt(lambda);
+    p->log_lambda = log(lambda);
+    p->b = 0.931 + 2.53 * root;
+    p->a = -0.059 + 0.02483 * p->b;
+    p->log_inverse_alpha = log(1.1239 + 1.1328 / (p->b - 3.4));
+    p->v_r = 0.9277 - 3.6224 / (p->b - 2);
+}
+
+static int poisson_sample(Rng *rng, const PoissonParams *p) {
+    if (p->lambda <= 0) return 0;
+
+    if (p->lambda < POISSON_PTRS_MIN) {
+        // Inversão: percorre a função de distribuição com uma só uniforme
+        double u = rng_uniform(rng);
+        double term = p->exp_neg_lambda;
+        double cumulative = term;
+        int k = 0;
+        while (u > cumulative && term > 0) {
+            k++;
+            term *= p->lambda / k;
+            cumulative += term;
+        }
+        return k;
+    }
+
+    // PTRS (Hörmann, 1993): aceitação rápida na zona central, teste exato
+    // pela densidade no resto
+    for (;;) {
+        double u = rng_uniform(rng) - 0.5;
+        double v = rng_uniform(rng);
+        double us = 0.5 - fabs(u);
+        long k = (long)floor((2 * p->a / us + p->b) * u + p->lambda + 0.43);
+        if (us >= 0.07 && v <= p->v_r) return (int)k;
+        if (k < 0 || (us < 0.013 && v > us)) continue;
+        if (log(v) + p->log_inverse_alpha - log(p->a / (us * us) + p->b) <=
+            -p->lambda + k * p->log_lambda - log_factorial(k)) {
+            return (int)k;
+        }
+    }
+}
+
+int poisson_distribution(Rng *rng, double lambda) {
+    PoissonParams params;
+    poisson_setup(&params, lambda);
+    return poisson_sample(rng, &params);
 }
 
-double exponential_distribution(double lambda) {
-    init_random();
-    return -log(1.0 - (double)rand() / RAND_MAX) / lambda;
+double exponential_distribution(Rng *rng, double lambda) {
+    pthread_once(&tables_once, init_tables);
+    return sample_standard_exponential(rng) / lambda;
+}
+
+// Inteiro uniforme em [0, range) sem enviesamento: multiplicação 32x32 e
+// rejeição apenas da fatia excedente (Lemire, 2019)
+static uint32_t bounded_u32(Rng *rng, uint32_t range) {
+    uint64_t product = (uint64_t)rng_next_u32(rng) * range;
+    uint32_t low = (uint32_t)product;
+    if (low < range) {
+        uint32_t threshold = -range % range;
+        while (low < threshold) {
+            product = (uint64_t)rng_next_u32(rng) * range;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
 }
 
-int uniform_distribution(int min, int max) {
-    init_random();
-    return min + rand() % (max - min + 1);
+int uniform_distribution(Rng *rng, int min, int max) {
+    if (max <= min) return min;
+    uint32_t range = (uint32_t)((int64_t)max - min + 1);
+    if (range == 0) return (int)rng_next_u32(rng);
+    return (int)((int64_t)min + bounded_u32(rng, range));
 }
 
-int normal_distribution(int mean, int stddev) {
-    init_random();
-    double u1 = (double)rand() / RAND_MAX;
-    double u2 = (double)rand() / RAND_MAX;
-    double z = sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+int normal_distribution(Rng *rng, int mean, int stddev) {
+    double z = standard_normal(rng);
     int value = mean + stddev * z;
     return (value < 1) ? 1 : value;
-}
\ No newline at end of file
+}
+
+void poisson_fill(Rng *rng, double lambda, int *out, int count) {
+    PoissonParams params;
+    poisson_setup(&params, lambda);
+    for (int i = 0; i < count; i++) {
+        out[i] = poisson_sample(rng, &params);
+    }
+}
+
+void exponential_fill(Rng *rng, double lambda, double *out, int count) {
+    pthread_once(&tables_once, init_tables);
+    double scale = 1.0 / lambda;
+    for (int i = 0; i < count; i++) {
+        out[i] = sample_standard_exponential(rng) * scale;
+    }
+}
+
+void uniform_fill(Rng *rng, int min, int max, int *out, int count) {
+    for (int i = 0; i < count; i++) {
+        out[i] = uniform_distribution(rng, min, max);
+    }
+}
+
+void normal_fill(Rng *rng, int mean, int stddev, int *out, int count) {
+    pthread_once(&tables_once, init_tables);
+    for (int i = 0; i < count; i++) {
+        int value = mean + stddev * sample_standard_normal(rng);
+        out[i] = (value < 1) ? 1 : value;
+    }
+}
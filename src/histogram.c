@@ -0,0 +1,110 @@
+#include "histogram.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+void histogram_reset(Histogram *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+void histogram_merge(Histogram *into, const Histogram *from) {
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        into->counts[b] += from->counts[b];
+    }
+    into->count += from->count;
+    if (from->max > into->max) into->max = from->max;
+}
+
+// Maior valor que cai no intervalo 'bucket'
+static long long bucket_upper_bound(int bucket) {
+    if (bucket < HISTOGRAM_SUB_BUCKETS) return bucket;
+    int k = bucket - HISTOGRAM_SUB_BUCKETS;
+    int shift = k / (HISTOGRAM_SUB_BUCKETS / 2) + 1;
+    long long sub = k % (HISTOGRAM_SUB_BUCKETS / 2) + HISTOGRAM_SUB_BUCKETS / 2;
+    return ((sub + 1) << shift) - 1;
+}
+
+// Número de registos que o percentil tem de cobrir
+static uint64_t percentile_target(uint64_t count, double percentile) {
+    if (percentile > 100) percentile = 100;
+    uint64_t target = (uint64_t)ceil(percentile / 100 * count);
+    return target < 1 ? 1 : target;
+}
+
+int histogram_percentile(const Histogram *h, double percentile) {
+    if (h->count == 0) return 0;
+    uint64_t target = percentile_target(h->count, percentile);
+
+    uint64_t seen = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        seen += h->counts[b];
+        if (seen >= target) {
+            long long value = bucket_upper_bound(b);
+            return value < h->max ? (int)value : h->max;
+        }
+    }
+    return h->max;
+}
+
+void sparse_histogram_init(SparseHistogram *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+void sparse_histogram_free(SparseHistogram *h) {
+    free(h->bins);
+    sparse_histogram_init(h);
+}
+
+void sparse_histogram_reset(SparseHistogram *h) {
+    h->size = 0;
+    h->count = 0;
+    h->max = 0;
+}
+
+int sparse_histogram_record(SparseHistogram *h, int value) {
+    int bucket = histogram_bucket(value);
+
+    // Pesquisa binária pelo primeiro intervalo >= bucket
+    int lo = 0, hi = h->size;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (h->bins[mid].bucket < bucket) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == h->size || h->bins[lo].bucket != bucket) {
+        if (h->size == h->capacity) {
+            int capacity = h->capacity ? h->capacity * 2 : 4;
+            HistogramBin *bins = realloc(h->bins, capacity * sizeof(HistogramBin));
+            if (!bins) return -1;
+            h->bins = bins;
+            h->capacity = capacity;
+        }
+        memmove(&h->bins[lo + 1], &h->bins[lo], (h->size - lo) * sizeof(HistogramBin));
+        // Sem bytes de enchimento por iniciar: os intervalos vão para os checkpoints
+        memset(&h->bins[lo], 0, sizeof(HistogramBin));
+        h->bins[lo].bucket = bucket;
+        h->size++;
+    }
+    h->bins[lo].count++;
+    h->count++;
+    if (value > h->max) h->max = value;
+    return 0;
+}
+
+int sparse_histogram_percentile(const SparseHistogram *h, double percentile) {
+    if (h->count == 0) return 0;
+    uint64_t target = percentile_target(h->count, percentile);
+
+    uint64_t seen = 0;
+    for (int b = 0; b < h->size; b++) {
+        seen += h->bins[b].count;
+        if (seen >= target) {
+            long long value = bucket_upper_bound(h->bins[b].bucket);
+            return value < h->max ? (int)value : h->max;
+        }
+    }
+    return h->max;
+}
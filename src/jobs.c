@@ -0,0 +1,117 @@
+#include "jobs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <stddef.h>
+
+int job_stats_init(JobStats *jobs, int n) {
+    jobs->n = n;
+    jobs->tasks = malloc((size_t)(n > 0 ? n : 1) * sizeof(TaskJobStats));
+    if (!jobs->tasks) return -1;
+    for (int i = 0; i < n; i++) {
+        sparse_histogram_init(&jobs->tasks[i].response_histogram);
+    }
+    job_stats_reset(jobs);
+    return 0;
+}
+
+void job_stats_free(JobStats *jobs) {
+    for (int i = 0; i < jobs->n; i++) {
+        sparse_histogram_free(&jobs->tasks[i].response_histogram);
+    }
+    free(jobs->tasks);
+    jobs->tasks = NULL;
+    jobs->n = 0;
+}
+
+void job_stats_reset(JobStats *jobs) {
+    for (int i = 0; i < jobs->n; i++) {
+        TaskJobStats *task = &jobs->tasks[i];
+        task->completed = task->late = task->dropped = 0;
+        task->response = (RunningStat){0};
+        task->worst_response = 0;
+        task->worst_start_delay = 0;
+        task->worst_lateness = INT_MIN;
+        sparse_histogram_reset(&task->response_histogram);
+    }
+}
+
+int job_stats_complete(JobStats *jobs, int i, int release, int start, int finish,
+                       int deadline) {
+    TaskJobStats *task = &jobs->tasks[i];
+    int response = finish - release;
+    int lateness = finish - deadline;
+    task->completed++;
+    if (lateness > 0) task->late++;
+    running_stat_add(&task->response, response);
+    if (response > task->worst_response) task->worst_response = response;
+    if (start - release > task->worst_start_delay) task->worst_start_delay = start - release;
+    if (lateness > task->worst_lateness) task->worst_lateness = lateness;
+    return sparse_histogram_record(&task->response_histogram, response);
+}
+
+// Os campos escalares de uma tarefa, que precedem o histograma
+#define TASK_SCALARS_SIZE offsetof(TaskJobStats, response_histogram)
+
+void job_stats_save(const JobStats *jobs, CheckpointWriter *w) {
+    for (int i = 0; i < jobs->n; i++) {
+        const TaskJobStats *task = &jobs->tasks[i];
+        const SparseHistogram *h = &task->response_histogram;
+        checkpoint_write(w, task, TASK_SCALARS_SIZE);
+        checkpoint_write(w, &h->count, sizeof(h->count));
+        checkpoint_write_int(w, h->max);
+        checkpoint_write_int(w, h->size);
+        checkpoint_write(w, h->bins, h->size * sizeof(HistogramBin));
+    }
+}
+
+void job_stats_load(JobStats *jobs, CheckpointReader *r) {
+    for (int i = 0; i < jobs->n && !r->failed; i++) {
+        TaskJobStats *task = &jobs->tasks[i];
+        SparseHistogram *h = &task->response_histogram;
+        checkpoint_read(r, task, TASK_SCALARS_SIZE);
+        checkpoint_read(r, &h->count, sizeof(h->count));
+        h->max = checkpoint_read_int(r);
+        int size = checkpoint_read_int(r);
+        if (size < 0 || size > HISTOGRAM_BUCKETS) {
+            r->failed = true;
+            break;
+        }
+        if (size > h->capacity) {
+            HistogramBin *bins = realloc(h->bins, size * sizeof(HistogramBin));
+            if (!bins) {
+                r->failed = true;
+                break;
+            }
+            h->bins = bins;
+            h->capacity = size;
+        }
+        h->size = size;
+        checkpoint_read(r, h->bins, size * sizeof(HistogramBin));
+    }
+}
+
+void print_job_stats(const JobStats *jobs, const ProcessTable *table) {
+    printf("\n=== Jobs por Tarefa ===\n\n");
+    printf("%-5s %-9s %11s %9s %11s %12s %8s %8s %10s %12s %11s\n",
+           "PID", "Período", "Concluídos", "Atrasados", "Descartados", "Resp. média",
+           "p99", "p99.9", "Pior resp.", "Pior início", "Pior atraso");
+    printf("-------------------------------------------------------------------------------"
+           "----------------------------------\n");
+
+    for (int i = 0; i < jobs->n; i++) {
+        const TaskJobStats *task = &jobs->tasks[i];
+        if (task->completed == 0 && task->dropped == 0) continue;
+        printf("%-5d %-8d %10lld %9lld %11lld %11.2f %8d %8d %10d %11d ",
+               table->pid[i], table->period[i], task->completed, task->late, task->dropped,
+               task->response.mean, sparse_histogram_percentile(&task->response_histogram, 99),
+               sparse_histogram_percentile(&task->response_histogram, 99.9), task->worst_response,
+               task->worst_start_delay);
+        // Sem jobs concluídos não há atraso definido
+        if (task->completed > 0) {
+            printf("%11d\n", task->worst_lateness);
+        } else {
+            printf("%11s\n", "-");
+        }
+    }
+}
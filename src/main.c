@@ -2,13 +2,55 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
 #include "process.h"
-#include "scheduler.h" 
+#include "scheduler.h"
 #include "distributions.h"
 #include "utils.h"
+#include "analysis.h"
+#include "replication.h"
+#include "stream.h"
+#include "workload.h"
+#include "output.h"
+#include "multicore.h"
+#include "counters.h"
+#include "compare.h"
+#include "sweep.h"
+#include "checkpoint.h"
+#include "jobs.h"
+
+// Opções da linha de comandos
+typedef struct {
+    int algorithm;
+    bool compare_all;
+    int num_processes;
+    int quantum;
+    bool analyze;
+    long long horizon_cap;
+    uint64_t seed;
+    int replications;
+    int threads;
+    bool stream;
+    double interarrival;
+    const char *workload;
+    OutputFormat output;
+    const char *results_path;
+    bool quiet;
+    int cpus;
+    bool partitioned;
+    const char *counters_path;
+    const char *sweep;
+    CheckpointConfig checkpoint;
+    bool jobs;
+} Options;
 
 void print_usage(const char *program_name) {
-    printf("Uso: %s <algoritmo> <num_processos> [quantum]\n", program_name);
+    printf("Uso: %s <algoritmo> <num_processos> [quantum] [opções]\n", program_name);
+    printf("     %s convert <carga.csv> <carga.bin>\n", program_name);
     printf("Algoritmos disponíveis:\n");
     printf("  FCFS          - First-Come, First-Served\n");
     printf("  SJF           - Shortest Job First\n");
@@ -17,89 +59,621 @@ void print_usage(const char *program_name) {
     printf("  RR            - Round Robin (requer quantum)\n");
     printf("  RM            - Rate Monotonic (para processos periódicos)\n");
     printf("  EDF           - Earliest Deadline First\n");
+    printf("  CFS           - Completely Fair Scheduler (quantum opcional: granularidade\n");
+    printf("                  mínima, por omissão %d; latência = %d × granularidade)\n",
+           CFS_DEFAULT_MIN_GRANULARITY, CFS_LATENCY_FACTOR);
+    printf("  ALL           - compara todos os algoritmos sobre a mesma carga (quantum de\n");
+    printf("                  RR por omissão: %d)\n", COMPARE_DEFAULT_QUANTUM);
+    printf("Opções:\n");
+    printf("  --analyze         - RM/EDF: teste de escalonabilidade analítico, sem simulação\n");
+    printf("  --horizon H       - RM/EDF: limite do horizonte de simulação (omissão: %lld)\n",
+           DEFAULT_HORIZON_CAP);
+    printf("  --seed S          - semente do gerador (omissão: baseada no relógio)\n");
+    printf("  --replications N  - executa N replicações independentes e mostra médias e IC 95%%\n");
+    printf("  --threads T       - threads usadas pelas replicações (omissão: nº de CPUs)\n");
+    printf("  --stream          - gera e retira processos em fluxo, com memória limitada aos\n");
+    printf("                      processos vivos (não suporta RM/EDF)\n");
+    printf("  --interarrival X  - intervalo médio entre chegadas em --stream (omissão: %.1f)\n",
+           STREAM_DEFAULT_INTERARRIVAL);
+    printf("  --workload F      - usa a carga binária F (gerada por convert) em vez de gerar\n");
+    printf("                      processos; num_processos limita quantos são usados\n");
+    printf("  --output F        - formato dos resultados por processo: table (omissão), csv\n");
+    printf("                      ou binary (colunas int32)\n");
+    printf("  --results R       - ficheiro para --output csv/binary (omissão: resultados.csv\n");
+    printf("                      ou resultados.bin)\n");
+    printf("  --quiet           - não mostra tabelas nem o Gantt, apenas as estatísticas\n");
+    printf("  --cpus M          - simula M CPUs com escalonamento global (fila partilhada)\n");
+    printf("  --partitioned     - com --cpus: cada processo fica fixo numa CPU\n");
+    printf("  --sweep GRELHA    - varre parâmetros e escreve uma linha CSV por ponto, p.ex.\n");
+    printf("                      quantum=1:20,n=100:100000:x10,lambda=0.1:1:0.1 (lambda:\n");
+    printf("                      taxa de chegadas); --results grava o CSV num ficheiro\n");
+    printf("  --checkpoint F    - RM/EDF (um CPU) e --stream: grava o estado da simulação em F\n");
+    printf("                      a intervalos de tempo simulado\n");
+    printf("  --checkpoint-every T - intervalo entre checkpoints (omissão: %d)\n",
+           CHECKPOINT_DEFAULT_INTERVAL);
+    printf("  --resume F        - continua a simulação a partir do checkpoint F (mesmos\n");
+    printf("                      algoritmo, parâmetros e semente; o Gantt só mostra o resto)\n");
+    printf("  --jobs            - RM/EDF (um CPU): resposta, atraso e percentis por tarefa,\n");
+    printf("                      acumulados job a job\n");
+    printf("  --counters F      - grava contadores e tempos por fase em JSON no ficheiro F\n");
+    printf("                      (requer compilação com make COUNTERS=1)\n");
 }
 
-int main(int argc, char *argv[]) {
-    if (argc < 3) {
-        print_usage(argv[0]);
+// Converte 'text' num inteiro em [min, max], como parse_field em
+// workload.c: rejeita texto vazio, caracteres a mais e valores fora do
+// intervalo
+static bool parse_long_long(const char *text, long long min, long long max, long long *value) {
+    char *end;
+    errno = 0;
+    long long parsed = strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || parsed < min || parsed > max) return false;
+    *value = parsed;
+    return true;
+}
+
+static bool parse_int(const char *text, int min, int *value) {
+    long long parsed;
+    if (!parse_long_long(text, min, INT_MAX, &parsed)) return false;
+    *value = (int)parsed;
+    return true;
+}
+
+// strtoull aceitaria um sinal e devolveria o valor negado
+static bool parse_seed(const char *text, uint64_t *value) {
+    if (*text < '0' || *text > '9') return false;
+    char *end;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*end != '\0' || errno != 0) return false;
+    *value = parsed;
+    return true;
+}
+
+static bool parse_positive_double(const char *text, double *value) {
+    char *end;
+    errno = 0;
+    double parsed = strtod(text, &end);
+    if (end == text || *end != '\0' || errno != 0 || !isfinite(parsed) || parsed <= 0) {
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+static int invalid_value(const char *option, const char *value) {
+    printf("Valor inválido para %s: %s\n", option, value);
+    return -1;
+}
+
+static int parse_options(int argc, char *argv[], Options *options) {
+    options->algorithm = parse_algorithm(argv[1]);
+    options->compare_all = strcmp(argv[1], "ALL") == 0;
+    if (!parse_int(argv[2], 1, &options->num_processes)) {
+        return invalid_value("num_processos", argv[2]);
+    }
+    options->quantum = 0;
+    options->analyze = false;
+    options->horizon_cap = DEFAULT_HORIZON_CAP;
+    options->seed = (uint64_t)time(NULL);
+    options->replications = 0;
+    options->threads = 0;
+    options->stream = false;
+    options->interarrival = STREAM_DEFAULT_INTERARRIVAL;
+    options->workload = NULL;
+    options->output = OUTPUT_TABLE;
+    options->results_path = NULL;
+    options->quiet = false;
+    options->cpus = 1;
+    options->partitioned = false;
+    options->counters_path = NULL;
+    options->sweep = NULL;
+    options->checkpoint = (CheckpointConfig){ .interval = CHECKPOINT_DEFAULT_INTERVAL };
+    options->jobs = false;
+
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--analyze") == 0) {
+            options->analyze = true;
+        } else if (strcmp(argv[i], "--horizon") == 0 && i + 1 < argc) {
+            if (!parse_long_long(argv[++i], 1, LLONG_MAX, &options->horizon_cap)) {
+                return invalid_value(argv[i - 1], argv[i]);
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            if (!parse_seed(argv[++i], &options->seed)) {
+                return invalid_value(argv[i - 1], argv[i]);
+            }
+        } else if (strcmp(argv[i], "--replications") == 0 && i + 1 < argc) {
+            if (!parse_int(argv[++i], 1, &options->replications)) {
+                return invalid_value(argv[i - 1], argv[i]);
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            if (!parse_int(argv[++i], 1, &options->threads)) {
+                return invalid_value(argv[i - 1], argv[i]);
+            }
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            options->stream = true;
+        } else if (strcmp(argv[i], "--interarrival") == 0 && i + 1 < argc) {
+            if (!parse_positive_double(argv[++i], &options->interarrival)) {
+                return invalid_value(argv[i - 1], argv[i]);
+            }
+        } else if (strcmp(argv[i], "--workload") == 0 && i + 1 < argc) {
+            options->workload = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            int format = parse_output_format(argv[++i]);
+            if (format < 0) {
+                printf("Formato de saída desconhecido: %s\n", argv[i]);
+                return -1;
+            }
+            options->output = (OutputFormat)format;
+        } else if (strcmp(argv[i], "--results") == 0 && i + 1 < argc) {
+            options->results_path = argv[++i];
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            options->quiet = true;
+        } else if (strcmp(argv[i], "--cpus") == 0 && i + 1 < argc) {
+            if (!parse_int(argv[++i], 1, &options->cpus)) {
+                return invalid_value(argv[i - 1], argv[i]);
+            }
+        } else if (strcmp(argv[i], "--partitioned") == 0) {
+            options->partitioned = true;
+        } else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            options->sweep = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            options->checkpoint.path = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) {
+            if (!parse_int(argv[++i], 1, &options->checkpoint.interval)) {
+                return invalid_value(argv[i - 1], argv[i]);
+            }
+        } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            options->checkpoint.resume = argv[++i];
+        } else if (strcmp(argv[i], "--jobs") == 0) {
+            options->jobs = true;
+        } else if (strcmp(argv[i], "--counters") == 0 && i + 1 < argc) {
+            options->counters_path = argv[++i];
+        } else if (argv[i][0] != '-' && options->quantum == 0) {
+            if (!parse_int(argv[i], 1, &options->quantum)) {
+                return invalid_value("quantum", argv[i]);
+            }
+        } else {
+            printf("Opção inválida: %s\n", argv[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Modo Monte-Carlo: só o resumo estatístico, sem tabelas nem Gantt
+static int run_replication_mode(const Options *options) {
+    ReplicationConfig config = {
+        .algorithm = options->algorithm,
+        .num_processes = options->num_processes,
+        .quantum = options->quantum,
+        .horizon_cap = options->horizon_cap,
+        .seed = options->seed,
+        .replications = options->replications,
+        .threads = options->threads
+    };
+
+    printf("\n=== %d replicações de %s com %d processos (semente %llu) ===\n",
+           options->replications, algorithm_description(options->algorithm),
+           options->num_processes, (unsigned long long)options->seed);
+
+    StatsAccumulator summary;
+    if (run_replications(&config, &summary) != 0) {
+        printf("Erro: não foi possível executar as replicações\n");
         return 1;
     }
+    print_stats_summary(&summary);
+    return 0;
+}
+
+static bool uses_checkpoints(const Options *options) {
+    return options->checkpoint.path || options->checkpoint.resume;
+}
+
+// Motor de um só CPU; RM/EDF passam pelos checkpoints e pela contabilidade
+// por job quando pedidos
+static int simulate(SimContext *ctx, Algorithm algorithm, ProcessTable *table,
+                    const Options *options, int horizon, Trace *trace, JobStats *jobs) {
+    if (uses_checkpoints(options) || jobs) {
+        const CheckpointConfig *checkpoint = uses_checkpoints(options) ? &options->checkpoint : NULL;
+        return run_real_time_jobs_in(ctx, algorithm, table, horizon, trace, checkpoint, jobs);
+    }
+    return run_algorithm_in(ctx, algorithm, table, options->quantum, horizon, trace);
+}
 
-    const char *algorithm = argv[1];
-    int num_processes = atoi(argv[2]);
-    int quantum = (argc > 3) ? atoi(argv[3]) : 0;
-    
-    if (num_processes <= 0) {
-        printf("Número de processos deve ser positivo!\n");
+// Modo streaming: a carga nunca é materializada; só o resumo estatístico
+static int run_stream_mode(const Options *options) {
+    if (algorithm_is_real_time(options->algorithm) || options->algorithm == ALG_CFS) {
+        printf("Erro: --stream não suporta algoritmos periódicos (RM/EDF) nem CFS\n");
         return 1;
     }
 
-    bool is_real_time = (strcmp(algorithm, "RM") == 0 || strcmp(algorithm, "EDF") == 0);
-    Process *processes = generate_processes(num_processes, is_real_time);
-    
-    print_initial_state(processes, num_processes);
+    printf("\n=== Executando %s em streaming (%d processos, semente %llu) ===\n",
+           algorithm_description(options->algorithm), options->num_processes,
+           (unsigned long long)options->seed);
 
-    // Executa o algoritmo selecionado
-    if (strcmp(algorithm, "FCFS") == 0) {
-        printf("\n=== Executando FCFS (First-Come, First-Served) ===\n");
-        run_fcfs(processes, num_processes);
-        print_non_preemptive(processes, num_processes);
-    } 
-    else if (strcmp(algorithm, "SJF") == 0) {
-        printf("\n=== Executando SJF (Shortest Job First) ===\n");
-        run_sjf(processes, num_processes);
-        print_non_preemptive(processes, num_processes);
+    GeneratedSource source;
+    generated_source_init(&source, options->num_processes, options->seed, options->interarrival);
+
+    const CheckpointConfig *checkpoint = uses_checkpoints(options) ? &options->checkpoint : NULL;
+    if (options->checkpoint.resume) printf("Retomando a partir de %s\n", options->checkpoint.resume);
+    StreamResult result;
+    SimContext ctx;
+    sim_context_init(&ctx);
+    int failed = run_stream_in(&ctx, options->algorithm, &source.base, options->quantum,
+                               checkpoint, &result) != 0;
+    sim_context_free(&ctx);
+    if (failed) {
+        // Uma retoma falhada já foi explicada pelo módulo de checkpoints
+        if (!options->checkpoint.resume) {
+            printf("Erro: memória insuficiente para a simulação em streaming\n");
+        }
+        return 1;
+    }
+    print_stream_result(&result);
+    return 0;
+}
+
+// Simulação normal: Gantt, resultados por processo e estatísticas; com
+// --quiet só as estatísticas (e o ficheiro de resultados, se pedido)
+static int run_simulation(Algorithm algorithm, ProcessTable *table, const Options *options) {
+    int horizon = 0;
+    if (algorithm_is_real_time(algorithm)) {
+        bool truncated;
+        horizon = simulation_horizon(table, options->horizon_cap, &truncated);
+        if (truncated) {
+            printf("Aviso: hiperperíodo excede o limite; simulação truncada em t=%d\n", horizon);
+        }
+    }
+
+    if (algorithm == ALG_RR) {
+        printf("\n=== Executando %s (Quantum=%d) ===\n",
+               algorithm_description(algorithm), options->quantum);
+    } else if (algorithm == ALG_CFS) {
+        int granularity = (options->quantum > 0) ? options->quantum : CFS_DEFAULT_MIN_GRANULARITY;
+        printf("\n=== Executando %s (Granularidade=%d, Latência=%d) ===\n",
+               algorithm_description(algorithm), granularity, CFS_LATENCY_FACTOR * granularity);
+    } else {
+        printf("\n=== Executando %s ===\n", algorithm_description(algorithm));
     }
-    else if (strcmp(algorithm, "PRIORITY_NP") == 0) {
-        printf("\n=== Executando Priority Scheduling não preemptivo ===\n");
-        run_priority_nonpreemptive(processes, num_processes);
-        print_non_preemptive(processes, num_processes);
+    if (options->cpus > 1) {
+        printf("%d CPUs, escalonamento %s\n", options->cpus,
+               options->partitioned ? "particionado" : "global");
     }
-    else if (strcmp(algorithm, "PRIORITY_P") == 0) {
-        printf("\n=== Executando Priority Scheduling preemptivo ===\n");
-        print_priority_preemptive(processes, num_processes);
+    if (algorithm == ALG_RM) {
+        SchedAnalysis rm = analyze_rm(table, NULL);
+        printf("Utilização: %.2f, Limite: %.2f\n", rm.utilization, rm.bound);
     }
-    else if (strcmp(algorithm, "RR") == 0) {
-        if (quantum <= 0) {
-            printf("Erro: RR requer um quantum positivo\n");
-            free_processes(processes);
+
+    // Executa o algoritmo selecionado; o motor só guarda os segmentos do
+    // traço se o Gantt for desenhado (não há Gantt com várias CPUs)
+    long long single_busy_time = 0;
+    long long *busy_time = &single_busy_time;
+    JobStats jobs;
+    JobStats *job_stats = NULL;
+    SimContext ctx;
+    if (options->cpus > 1) {
+        MulticoreConfig config = {
+            .mode = options->partitioned ? MULTICORE_PARTITIONED : MULTICORE_GLOBAL,
+            .cpus = options->cpus,
+            .quantum = options->quantum,
+            .horizon = horizon,
+            .threads = options->threads
+        };
+        busy_time = malloc(options->cpus * sizeof(long long));
+        PHASE_BEGIN(PHASE_SIMULATION);
+        sim_context_init(&ctx);
+        int failed = !busy_time || run_multicore_in(&ctx, algorithm, table, &config, busy_time) != 0;
+        sim_context_free(&ctx);
+        PHASE_END(PHASE_SIMULATION);
+        if (failed) {
+            printf("Erro: memória insuficiente para a simulação com %d CPUs\n", options->cpus);
+            free(busy_time);
+            return 1;
+        }
+    } else {
+        if (options->jobs) {
+            if (job_stats_init(&jobs, table->n) != 0) {
+                printf("Erro: memória insuficiente para a contabilidade por job\n");
+                return 1;
+            }
+            job_stats = &jobs;
+        }
+        Trace trace;
+        if (options->quiet) {
+            trace_init_summary(&trace);
+        } else {
+            trace_init(&trace);
+        }
+        if (options->checkpoint.resume) printf("Retomando a partir de %s\n", options->checkpoint.resume);
+        PHASE_BEGIN(PHASE_SIMULATION);
+        sim_context_init(&ctx);
+        int failed = simulate(&ctx, algorithm, table, options, horizon, &trace, job_stats) != 0;
+        sim_context_free(&ctx);
+        PHASE_END(PHASE_SIMULATION);
+        if (failed) {
+            // Uma retoma falhada já foi explicada pelo módulo de checkpoints
+            if (!options->checkpoint.resume) printf("Erro: memória insuficiente para a simulação\n");
+            trace_free(&trace);
+            if (job_stats) job_stats_free(job_stats);
             return 1;
         }
-        printf("\n=== Executando Round Robin (Quantum=%d) ===\n", quantum);
-        run_rr(processes, num_processes, quantum);
-        print_rr(processes, num_processes, quantum);
+        if (!options->quiet) {
+            PHASE_BEGIN(PHASE_RENDERING);
+            print_gantt(&trace);
+            PHASE_END(PHASE_RENDERING);
+        }
+        single_busy_time = trace.busy_time;
+        trace_free(&trace);
+    }
+
+    // Mostra ou grava os resultados
+    int status = 0;
+    PHASE_BEGIN(PHASE_RENDERING);
+    if (options->output != OUTPUT_TABLE) {
+        const char *path = options->results_path ? options->results_path
+                                                 : output_default_path(options->output);
+        if (write_results(table, options->output, path) == 0) {
+            printf("\nResultados escritos em %s\n", path);
+        } else {
+            status = 1;
+        }
+    } else if (!options->quiet) {
+        print_final_results(table);
+    }
+    PHASE_END(PHASE_RENDERING);
+
+    PHASE_BEGIN(PHASE_STATS);
+    SchedulerStats stats = algorithm_stats(algorithm, table, horizon, busy_time, options->cpus);
+    calculate_percentiles(table, &stats);
+    PHASE_END(PHASE_STATS);
+    if (options->cpus > 1) {
+        if (!options->quiet) {
+            print_cpu_utilization(busy_time, options->cpus,
+                                  algorithm_total_time(algorithm, table, horizon));
+        }
+        free(busy_time);
+    }
+    print_stats(stats);
+    if (job_stats) {
+        print_job_stats(job_stats, table);
+        job_stats_free(job_stats);
+    }
+    return status;
+}
+
+// Modo de comparação: todos os algoritmos sobre a mesma carga, só leitura
+static int run_compare_mode(const ProcessTable *table, const Options *options) {
+    CompareConfig config = {
+        .quantum = options->quantum > 0 ? options->quantum : COMPARE_DEFAULT_QUANTUM,
+        .threads = options->threads
+    };
+    bool truncated;
+    config.horizon = simulation_horizon(table, options->horizon_cap, &truncated);
+    if (truncated) {
+        printf("Aviso: hiperperíodo excede o limite; RM/EDF truncados em t=%d\n", config.horizon);
+    }
+
+    printf("\n=== Executando todos os algoritmos (Quantum=%d) ===\n", config.quantum);
+    CompareResult results[ALG_COUNT];
+    run_comparison(table, &config, results);
+    print_comparison(results, ALG_COUNT);
+
+    for (int a = 0; a < ALG_COUNT; a++) {
+        if (!results[a].ok) return 1;
+    }
+    return 0;
+}
+
+// Modo de varrimento: grelha de parâmetros, uma linha CSV por ponto
+static int run_sweep_mode(const Options *options) {
+    if (options->replications > 0 || options->stream || options->analyze || options->cpus > 1 ||
+        options->workload || options->output != OUTPUT_TABLE) {
+        printf("Erro: --sweep não se aplica a --replications, --stream, --analyze, --cpus,\n"
+               "--workload nem --output\n");
+        return 1;
     }
-    else if (strcmp(algorithm, "RM") == 0) {
-        printf("\n=== Executando Rate Monotonic Scheduling ===\n");
-        run_rate_monotonic(processes, num_processes);
-        print_rm(processes, num_processes);
+
+    SweepConfig config = {
+        .algorithm = (Algorithm)options->algorithm,
+        .horizon_cap = options->horizon_cap,
+        .seed = options->seed,
+        .threads = options->threads,
+        .output = options->results_path
+    };
+    sweep_range_single(&config.quantum, options->quantum);
+    sweep_range_single(&config.processes, options->num_processes);
+    sweep_range_single(&config.lambda, 0);
+    if (parse_sweep(options->sweep, &config) != 0) return 1;
+
+    if (config.quantum.set && config.algorithm != ALG_RR && config.algorithm != ALG_CFS) {
+        printf("Erro: quantum só se aplica a RR e CFS\n");
+        return 1;
     }
-    else if (strcmp(algorithm, "EDF") == 0) {
-        printf("\n=== Executando Earliest Deadline First Scheduling ===\n");
-        run_edf(processes, num_processes);
-        print_edf(processes, num_processes);
+    if (config.algorithm == ALG_RR && !config.quantum.set && options->quantum <= 0) {
+        printf("Erro: RR requer um quantum positivo\n");
+        return 1;
     }
-    else {
+    if (config.lambda.set && algorithm_is_real_time(config.algorithm)) {
+        printf("Erro: lambda não se aplica a algoritmos periódicos (RM/EDF)\n");
+        return 1;
+    }
+    return run_sweep(&config);
+}
+
+// Converte uma carga CSV para o formato binário mapeável
+static int run_convert(const char *csv_path, const char *out_path) {
+    long long count = workload_convert_csv(csv_path, out_path);
+    if (count < 0) return 1;
+    printf("%lld processos escritos em %s\n", count, out_path);
+    return 0;
+}
+
+// Grava os contadores da execução em JSON (stderr se não houver ficheiro)
+static int dump_counters(const char *path) {
+#ifdef PROBSCHED_COUNTERS
+    if (!path) {
+        counters_dump_json(stderr);
+        return 0;
+    }
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        perror(path);
+        return 1;
+    }
+    counters_dump_json(out);
+    fclose(out);
+    return 0;
+#else
+    (void)path;
+    return 0;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 4 && strcmp(argv[1], "convert") == 0) {
+        return run_convert(argv[2], argv[3]);
+    }
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    Options options;
+    if (parse_options(argc, argv, &options) != 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (options.algorithm < 0 && !options.compare_all) {
         printf("Erro: Algoritmo desconhecido!\n");
         print_usage(argv[0]);
-        free_processes(processes);
         return 1;
     }
+    if (uses_checkpoints(&options)) {
+        bool single_real_time = algorithm_is_real_time((Algorithm)options.algorithm) &&
+                                options.cpus == 1 && !options.analyze &&
+                                options.replications == 0;
+        if (options.compare_all || options.sweep || !(options.stream || single_real_time)) {
+            printf("Erro: --checkpoint e --resume só se aplicam a RM/EDF com um CPU (sem\n"
+                   "--analyze nem --replications) e a --stream\n");
+            return 1;
+        }
+    }
+    if (options.jobs && (!algorithm_is_real_time((Algorithm)options.algorithm) ||
+                         options.compare_all || options.sweep || options.cpus != 1 ||
+                         options.analyze || options.replications > 0)) {
+        printf("Erro: --jobs só se aplica a RM/EDF com um CPU (sem --analyze,\n"
+               "--replications nem --sweep)\n");
+        return 1;
+    }
+    if (options.sweep && !options.compare_all) {
+        return run_sweep_mode(&options);
+    }
+    if (options.algorithm == ALG_RR && options.quantum <= 0) {
+        printf("Erro: RR requer um quantum positivo\n");
+        return 1;
+    }
+#ifndef PROBSCHED_COUNTERS
+    if (options.counters_path) {
+        printf("Erro: --counters requer compilação com make COUNTERS=1\n");
+        return 1;
+    }
+#endif
+
+    Algorithm algorithm = (Algorithm)options.algorithm;
+    int num_processes = options.num_processes;
+
+    if (options.cpus > 1 && algorithm == ALG_CFS && !options.partitioned) {
+        printf("Erro: CFS usa uma fila por CPU; com --cpus requer --partitioned\n");
+        return 1;
+    }
+    if (options.cpus > 1 && (options.replications > 0 || options.stream || options.analyze)) {
+        printf("Erro: --cpus não se aplica a --replications, --stream nem --analyze\n");
+        return 1;
+    }
+    if (options.workload && (options.replications > 0 || options.stream)) {
+        printf("Erro: --workload não se aplica a --replications nem a --stream\n");
+        return 1;
+    }
+    if (options.compare_all && (options.replications > 0 || options.stream || options.analyze ||
+                                options.cpus > 1 || options.output != OUTPUT_TABLE ||
+                                options.sweep)) {
+        printf("Erro: ALL não se aplica a --replications, --stream, --analyze, --cpus,\n"
+               "--output nem --sweep\n");
+        return 1;
+    }
+    if (options.replications > 0) {
+        return run_replication_mode(&options);
+    }
+    if (options.stream) {
+        return run_stream_mode(&options);
+    }
 
-    // Calcula tempo total de execução
-    int total_time = 0;
-    for (int i = 0; i < num_processes; i++) {
-        if (processes[i].completion_time > total_time) {
-            total_time = processes[i].completion_time;
+    // A comparação inclui RM/EDF, pelo que a carga leva períodos e deadlines
+    bool is_real_time = options.compare_all || algorithm_is_real_time(algorithm);
+    ProcessTable generated;
+    MappedWorkload workload;
+    ProcessTable *table;
+    PHASE_BEGIN(PHASE_GENERATION);
+    if (options.workload) {
+        if (workload_open(&workload, options.workload, num_processes) != 0) return 1;
+        table = &workload.table;
+    } else {
+        if (process_table_init(&generated, num_processes) != 0) {
+            perror("Erro ao alocar memória para processos");
+            return 1;
         }
+        generate_processes(&generated, is_real_time, options.seed);
+        table = &generated;
     }
+    // Ordem de chegada partilhada pelos motores
+    if (process_table_index_arrivals(table) != 0) {
+        perror("Erro ao alocar memória para a ordem de chegada");
+        if (options.workload) {
+            workload_close(&workload);
+        } else {
+            process_table_free(&generated);
+        }
+        return 1;
+    }
+    PHASE_END(PHASE_GENERATION);
 
-    // Mostra resultados
-    print_final_results(processes, num_processes);
-    
-    SchedulerStats stats = calculate_stats(processes, num_processes, total_time);
-    print_stats(stats);
-    
-    free_processes(processes);
-    return 0;
+    // A tabela inicial só é útil no modo de texto: os ficheiros de
+    // resultados já incluem os atributos de entrada
+    if (options.output == OUTPUT_TABLE && !options.quiet) {
+        PHASE_BEGIN(PHASE_RENDERING);
+        print_initial_state(table);
+        PHASE_END(PHASE_RENDERING);
+    }
+    if (options.workload) {
+        printf("\nCarga: %s (%d processos)\n", options.workload, table->n);
+    } else {
+        printf("\nSemente: %llu\n", (unsigned long long)options.seed);
+    }
+
+    // Modo analítico: responde à escalonabilidade sem simular
+    int status = 0;
+    if (options.compare_all) {
+        status = run_compare_mode(table, &options);
+        if (dump_counters(options.counters_path) != 0) status = 1;
+    } else if (options.analyze) {
+        if (algorithm == ALG_RM) {
+            print_rm_analysis(table);
+        } else if (algorithm == ALG_EDF) {
+            print_edf_analysis(table);
+        } else {
+            printf("Erro: --analyze só se aplica a RM e EDF\n");
+            status = 1;
+        }
+    } else {
+        status = run_simulation(algorithm, table, &options);
+        if (dump_counters(options.counters_path) != 0) status = 1;
+    }
+
+    if (options.workload) {
+        workload_close(&workload);
+    } else {
+        process_table_free(&generated);
+    }
+    return status;
 }
\ No newline at end of file
@@ -0,0 +1,594 @@
+#include "multicore.h"
+#include "ready_queue.h"
+#include "parallel.h"
+#include "trace.h"
+#include "counters.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <limits.h>
+
+// Escalonamento global: simulação orientada a eventos com uma fila de prontos
+// partilhada. Cada evento custa O(log n + log m), pelo que o número de CPUs
+// simuladas só pesa na memória (O(m)).
+typedef struct {
+    Algorithm algorithm;
+    ProcessTable *table;
+    int quantum;
+    bool periodic;       // RM/EDF: jobs libertados periodicamente até ao horizonte
+    bool preemptive;     // PRIORITY_P, RM e EDF
+
+    int *job_key;        // Prioridade do job corrente (menor é mais prioritário)
+    int *cpu_of;         // CPU onde cada processo executa (-1 se não executa)
+    int *next_release;   // RM/EDF
+    int *job_deadline;   // RM/EDF: deadline absoluto do job corrente
+    int *negated_index;  // Desempate da fila de vítimas (maior índice primeiro)
+
+    int *running;        // Processo em cada CPU (-1 se ociosa)
+    int *segment_start;  // Início do segmento corrente em cada CPU
+    long long *busy_time;
+
+    ReadyQueue ready;    // Processos prontos que não estão a executar
+    FifoQueue fifo;      // RR: prontos por ordem de chegada à fila
+    ReadyQueue events;   // CPUs ocupadas, pelo fim do segmento corrente
+    ReadyQueue idle;     // CPUs ociosas, pelo índice
+    ReadyQueue victims;  // Processos em execução, o menos prioritário no topo
+    ReadyQueue releases; // RM/EDF: tarefas pela próxima libertação
+    FifoQueue requeue;   // RR: quanta esgotados, recolocados após as chegadas
+    int completed;
+} GlobalSim;
+
+// Toda a memória da simulação global vem de 'arena': nada é libertado
+static int global_init(GlobalSim *g, Algorithm algorithm, ProcessTable *table,
+                       const MulticoreConfig *config, long long *busy_time, Arena *arena) {
+    int n = table->n;
+    int cpus = config->cpus;
+    memset(g, 0, sizeof(*g));
+    g->algorithm = algorithm;
+    g->table = table;
+    g->quantum = config->quantum;
+    g->periodic = algorithm_is_real_time(algorithm);
+    g->preemptive = (algorithm == ALG_PRIORITY_P || g->periodic);
+    g->busy_time = busy_time;
+
+    g->job_key = arena_alloc_ints(arena, n);
+    g->cpu_of = arena_alloc_ints(arena, n);
+    g->next_release = arena_alloc_ints(arena, n);
+    g->job_deadline = arena_alloc_ints(arena, n);
+    g->negated_index = arena_alloc_ints(arena, n);
+    g->running = arena_alloc_ints(arena, cpus);
+    g->segment_start = arena_alloc_ints(arena, cpus);
+    // Cada processo está no máximo numa das filas RR, e só os que esgotaram
+    // o quantum numa CPU (no máximo um por CPU) passam pela de recolocação
+    if (!g->job_key || !g->cpu_of || !g->next_release || !g->job_deadline ||
+        !g->negated_index || !g->running || !g->segment_start ||
+        ready_queue_init_arena(&g->ready, n, arena) != 0 ||
+        fifo_queue_init_arena(&g->fifo, n, arena) != 0 ||
+        ready_queue_init_arena(&g->events, cpus, arena) != 0 ||
+        ready_queue_init_arena(&g->idle, cpus, arena) != 0 ||
+        ready_queue_init_arena(&g->victims, n, arena) != 0 ||
+        ready_queue_init_arena(&g->releases, n, arena) != 0 ||
+        fifo_queue_init_arena(&g->requeue, cpus, arena) != 0) {
+        return -1;
+    }
+    g->victims.tiebreak = g->negated_index;
+
+    for (int cpu = 0; cpu < cpus; cpu++) {
+        g->running[cpu] = -1;
+        g->segment_start[cpu] = 0;
+        busy_time[cpu] = 0;
+        ready_queue_push(&g->idle, cpu, cpu);
+    }
+    for (int i = 0; i < n; i++) {
+        g->cpu_of[i] = -1;
+        g->negated_index[i] = -i;
+        g->job_deadline[i] = 0;
+        switch (algorithm) {
+            case ALG_FCFS: g->job_key[i] = table->arrival_time[i]; break;
+            case ALG_SJF:  g->job_key[i] = table->burst_time[i]; break;
+            default:       g->job_key[i] = table->priority[i]; break;
+        }
+    }
+    return 0;
+}
+
+// (chave, índice) de i precede o de j?
+static bool higher_priority(const GlobalSim *g, int i, int j) {
+    if (g->job_key[i] != g->job_key[j]) return g->job_key[i] < g->job_key[j];
+    return i < j;
+}
+
+// Tempo de resposta, registado enquanto o processo (ou o job corrente) ainda
+// não executou nada
+static void record_response(GlobalSim *g, int i, int now) {
+    ProcessTable *table = g->table;
+    if (table->remaining_time[i] == table->burst_time[i]) {
+        int release = table->arrival_time[i];
+        if (g->periodic && table->period[i] > 0) release = g->next_release[i] - table->period[i];
+        table->response_time[i] = now - release;
+    }
+}
+
+static void start_segment(GlobalSim *g, int cpu, int i, int now) {
+    ProcessTable *table = g->table;
+    record_response(g, i, now);
+    int slice = table->remaining_time[i];
+    if (g->algorithm == ALG_RR && slice > g->quantum) slice = g->quantum;
+    COUNTER_INC(decisions);
+    COUNTER_INC(context_switches);
+    g->running[cpu] = i;
+    g->cpu_of[i] = cpu;
+    g->segment_start[cpu] = now;
+    ready_queue_push(&g->events, cpu, now + slice);
+    if (g->preemptive) ready_queue_push(&g->victims, i, -g->job_key[i]);
+}
+
+// Contabiliza o trabalho feito na CPU desde o início do segmento corrente
+static void account_segment(GlobalSim *g, int cpu, int now) {
+    int i = g->running[cpu];
+    int run = now - g->segment_start[cpu];
+    // Um job libertado com a tarefa em execução continua na CPU sem passar
+    // por start_segment: a resposta só é registada quando executa de facto
+    if (run > 0) record_response(g, i, g->segment_start[cpu]);
+    g->table->remaining_time[i] -= run;
+    g->busy_time[cpu] += run;
+    g->segment_start[cpu] = now;
+}
+
+// Retira o processo da CPU; devolve o processo
+static int vacate(GlobalSim *g, int cpu) {
+    int i = g->running[cpu];
+    g->running[cpu] = -1;
+    g->cpu_of[i] = -1;
+    if (ready_queue_contains(&g->events, cpu)) ready_queue_remove(&g->events, cpu);
+    if (g->preemptive) ready_queue_remove(&g->victims, i);
+    return i;
+}
+
+static void complete(GlobalSim *g, int i, int now) {
+    ProcessTable *table = g->table;
+    table->completion_time[i] = now;
+    table->waiting_time[i] = now - table->arrival_time[i] - table->burst_time[i];
+    if (g->periodic && now > g->job_deadline[i]) {
+        table->deadline_misses[i]++;
+    }
+    g->completed++;
+}
+
+// Segmentos que terminam até 'now': conclusões e, em RR, quanta esgotados
+static void finish_segments(GlobalSim *g, int now) {
+    while (!ready_queue_empty(&g->events)) {
+        int cpu = ready_queue_peek(&g->events);
+        int end = ready_queue_key(&g->events, cpu);
+        if (end > now) break;
+
+        account_segment(g, cpu, end);
+        int i = vacate(g, cpu);
+        ready_queue_push(&g->idle, cpu, cpu);
+        if (g->table->remaining_time[i] == 0) {
+            complete(g, i, end);
+        } else {
+            fifo_queue_push(&g->requeue, i);
+        }
+    }
+}
+
+// Libertação de jobs RM/EDF; um job ainda pendente perdeu o deadline e é
+// substituído pelo novo (na mesma CPU, se estiver a executar)
+static void release_jobs(GlobalSim *g, int now, int horizon) {
+    ProcessTable *table = g->table;
+    while (!ready_queue_empty(&g->releases) &&
+           ready_queue_key(&g->releases, ready_queue_peek(&g->releases)) <= now) {
+        int i = ready_queue_peek(&g->releases);
+        int cpu = g->cpu_of[i];
+        COUNTER_INC(releases);
+        if (cpu >= 0) account_segment(g, cpu, now);
+        if (table->remaining_time[i] > 0) {
+            table->deadline_misses[i]++;
+        }
+        table->remaining_time[i] = table->burst_time[i];
+
+        if (table->period[i] > 0) {
+            g->next_release[i] += table->period[i];
+            g->job_deadline[i] = g->next_release[i] - table->period[i] +
+                                 process_relative_deadline(table, i);
+        } else {
+            g->job_deadline[i] = table->deadline[i];
+        }
+        g->job_key[i] = (g->algorithm == ALG_RM) ? table->period[i] : g->job_deadline[i];
+
+        if (cpu >= 0) {
+            // O novo job continua na mesma CPU, sem esperar
+            ready_queue_update(&g->events, cpu, now + table->remaining_time[i]);
+            ready_queue_update(&g->victims, i, -g->job_key[i]);
+        } else {
+            ready_queue_update(&g->ready, i, g->job_key[i]);
+        }
+
+        if (table->period[i] > 0 && g->next_release[i] < horizon) {
+            ready_queue_update(&g->releases, i, g->next_release[i]);
+        } else {
+            ready_queue_remove(&g->releases, i);
+        }
+    }
+}
+
+static void make_ready(GlobalSim *g, int i) {
+    if (g->algorithm == ALG_RR) {
+        fifo_queue_push(&g->fifo, i);
+    } else {
+        ready_queue_push(&g->ready, i, g->job_key[i]);
+    }
+}
+
+// Ocupa as CPUs ociosas (menor índice primeiro) e, nos algoritmos
+// preemptivos, troca o processo menos prioritário em execução enquanto
+// houver um pronto mais prioritário
+static void dispatch(GlobalSim *g, int now) {
+    while (!ready_queue_empty(&g->idle)) {
+        int i = (g->algorithm == ALG_RR) ? fifo_queue_pop(&g->fifo) : ready_queue_pop(&g->ready);
+        if (i == -1) return;
+        start_segment(g, ready_queue_pop(&g->idle), i, now);
+    }
+    if (!g->preemptive) return;
+
+    while (!ready_queue_empty(&g->ready)) {
+        int i = ready_queue_peek(&g->ready);
+        int victim = ready_queue_peek(&g->victims);
+        if (!higher_priority(g, i, victim)) break;
+
+        int cpu = g->cpu_of[victim];
+        COUNTER_INC(preemptions);
+        account_segment(g, cpu, now);
+        vacate(g, cpu);
+        ready_queue_pop(&g->ready);
+        ready_queue_push(&g->ready, victim, g->job_key[victim]);
+        start_segment(g, cpu, i, now);
+    }
+}
+
+static int run_global(Algorithm algorithm, ProcessTable *table, const MulticoreConfig *config,
+                      long long *busy_time, Arena *arena) {
+    GlobalSim g;
+    ArrivalCursor arrivals = {0};
+    if (global_init(&g, algorithm, table, config, busy_time, arena) != 0) return -1;
+    if (!g.periodic && arrival_cursor_open_arena(&arrivals, table, arena) != 0) return -1;
+
+    int n = table->n;
+    int horizon = config->horizon;
+    for (int i = 0; i < n; i++) {
+        if (g.periodic) {
+            table->remaining_time[i] = 0;
+            table->deadline_misses[i] = 0;
+            g.next_release[i] = table->arrival_time[i];
+            bool released = (algorithm == ALG_EDF || table->period[i] > 0);
+            if (released && g.next_release[i] < horizon) {
+                ready_queue_push(&g.releases, i, g.next_release[i]);
+            }
+        } else {
+            table->remaining_time[i] = table->burst_time[i];
+            table->waiting_time[i] = 0;
+        }
+    }
+
+    for (;;) {
+        int now = INT_MAX;
+        if (!ready_queue_empty(&g.events)) {
+            now = ready_queue_key(&g.events, ready_queue_peek(&g.events));
+        }
+        if (g.periodic) {
+            if (!ready_queue_empty(&g.releases)) {
+                int release = ready_queue_key(&g.releases, ready_queue_peek(&g.releases));
+                if (release < now) now = release;
+            }
+            if (now >= horizon) {
+                finish_segments(&g, horizon);
+                break;
+            }
+        } else {
+            if (g.completed == n) break;
+            int arrival = arrival_cursor_peek_time(&arrivals);
+            if (arrival < now) now = arrival;
+        }
+
+        finish_segments(&g, now);
+        if (g.periodic) {
+            release_jobs(&g, now, horizon);
+        } else {
+            int i;
+            while ((i = arrival_cursor_next(&arrivals, now)) != -1) {
+                make_ready(&g, i);
+            }
+        }
+
+        // RR: quem chegou durante o quantum entra na fila antes dos preemptados
+        int i;
+        while ((i = fifo_queue_pop(&g.requeue)) != -1) {
+            fifo_queue_push(&g.fifo, i);
+        }
+        dispatch(&g, now);
+    }
+
+    if (g.periodic) {
+        // Trabalho feito até ao horizonte e jobs por terminar cujo deadline já passou
+        for (int cpu = 0; cpu < config->cpus; cpu++) {
+            if (g.running[cpu] >= 0) account_segment(&g, cpu, horizon);
+        }
+        for (int i = 0; i < n; i++) {
+            if (table->remaining_time[i] > 0 && g.job_deadline[i] <= horizon) {
+                table->deadline_misses[i]++;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Escalonamento particionado: atribuição gulosa à CPU menos carregada, com
+// as partições simuladas em paralelo pelos motores de uma CPU
+
+typedef struct {
+    double load;
+    int index;
+} LoadEntry;
+
+static int compare_load_desc(const void *a, const void *b) {
+    const LoadEntry *e1 = (const LoadEntry *)a;
+    const LoadEntry *e2 = (const LoadEntry *)b;
+    if (e1->load != e2->load) return (e1->load > e2->load) ? -1 : 1;
+    return (e1->index > e2->index) - (e1->index < e2->index);
+}
+
+// Heap mínimo de CPUs por (carga, índice); só é preciso descer o topo
+static void load_sift_down(int *heap, int cpus, const double *load) {
+    int i = 0;
+    int cpu = heap[0];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= cpus) break;
+        int right = child + 1;
+        if (right < cpus && (load[heap[right]] < load[heap[child]] ||
+            (load[heap[right]] == load[heap[child]] && heap[right] < heap[child]))) {
+            child = right;
+        }
+        if (load[cpu] < load[heap[child]] ||
+            (load[cpu] == load[heap[child]] && cpu < heap[child])) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = cpu;
+}
+
+// Preenche assignment[i] com a CPU do processo i
+static int assign_partitions(Algorithm algorithm, const ProcessTable *table, int cpus,
+                             int *assignment, Arena *arena) {
+    int n = table->n;
+    LoadEntry *entries = arena_alloc(arena, (size_t)(n > 0 ? n : 1) * sizeof(LoadEntry));
+    double *load = arena_alloc(arena, (size_t)cpus * sizeof(double));
+    int *heap = arena_alloc_ints(arena, cpus);
+    ArrivalCursor arrivals = {0};
+    bool real_time = algorithm_is_real_time(algorithm);
+    if (!entries || !load || !heap ||
+        (!real_time && arrival_cursor_open_arena(&arrivals, table, arena) != 0)) {
+        return -1;
+    }
+
+    // RM/EDF: utilização decrescente (worst-fit decreasing); restantes: ordem
+    // de chegada, com a carga medida em tempo de burst
+    for (int k = 0; k < n; k++) {
+        int i = real_time ? k : arrivals.order[k];
+        entries[k].index = i;
+        if (!real_time) {
+            entries[k].load = table->burst_time[i];
+        } else if (table->period[i] > 0) {
+            entries[k].load = (double)table->burst_time[i] / table->period[i];
+        } else {
+            entries[k].load = 0;
+        }
+    }
+    if (real_time) {
+        qsort(entries, n, sizeof(LoadEntry), compare_load_desc);
+    }
+
+    for (int cpu = 0; cpu < cpus; cpu++) {
+        heap[cpu] = cpu;
+        load[cpu] = 0;
+    }
+    for (int k = 0; k < n; k++) {
+        int cpu = heap[0];
+        assignment[entries[k].index] = cpu;
+        load[cpu] += entries[k].load;
+        load_sift_down(heap, cpus, load);
+    }
+    return 0;
+}
+
+typedef struct {
+    Algorithm algorithm;
+    ProcessTable *table;
+    ProcessTable *parts;    // Cópia da carga agrupada por CPU (linhas pela ordem de members)
+    const MulticoreConfig *config;
+    const int *members;     // Processos de cada CPU, por índice crescente
+    const int *offset;      // Membros da CPU c em [offset[c], offset[c + 1])
+    long long *busy_time;
+    SimContext *contexts;   // Um por worker, reutilizado entre as CPUs que simula
+#ifdef PROBSCHED_COUNTERS
+    SimCounters *worker_counters;   // Contagens dos workers além da thread chamadora
+#endif
+    atomic_bool failed;
+} PartitionJob;
+
+// Linhas [first, first + count) de 'parts' como uma tabela com count processos
+static void partition_rows(ProcessTable *sub, ProcessTable *parts, int first, int count) {
+    memset(sub, 0, sizeof(*sub));
+    sub->n = count;
+    sub->pid = parts->pid + first;
+    sub->arrival_time = parts->arrival_time + first;
+    sub->burst_time = parts->burst_time + first;
+    sub->priority = parts->priority + first;
+    sub->deadline = parts->deadline + first;
+    sub->period = parts->period + first;
+    sub->remaining_time = parts->remaining_time + first;
+    sub->completion_time = parts->completion_time + first;
+    sub->waiting_time = parts->waiting_time + first;
+    sub->response_time = parts->response_time + first;
+    sub->deadline_misses = parts->deadline_misses + first;
+}
+
+static void run_partition(int cpu, int worker, void *arg) {
+    PartitionJob *job = (PartitionJob *)arg;
+    ProcessTable *table = job->table;
+    int first = job->offset[cpu];
+    const int *members = job->members + first;
+    int count = job->offset[cpu + 1] - first;
+#ifdef PROBSCHED_COUNTERS
+    SimCounters before = sim_counters;
+#endif
+
+    job->busy_time[cpu] = 0;
+    if (count == 0) return;
+
+    // Subtabela com a carga da partição, simulada como uma CPU isolada
+    ProcessTable sub;
+    partition_rows(&sub, job->parts, first, count);
+    for (int k = 0; k < count; k++) {
+        int i = members[k];
+        sub.pid[k] = table->pid[i];
+        sub.arrival_time[k] = table->arrival_time[i];
+        sub.burst_time[k] = table->burst_time[i];
+        sub.priority[k] = table->priority[i];
+        sub.deadline[k] = table->deadline[i];
+        sub.period[k] = table->period[i];
+        sub.completion_time[k] = table->completion_time[i];
+        sub.waiting_time[k] = table->waiting_time[i];
+        sub.response_time[k] = table->response_time[i];
+        sub.deadline_misses[k] = table->deadline_misses[i];
+    }
+
+    Trace usage;
+    trace_init_summary(&usage);
+    if (run_algorithm_in(&job->contexts[worker], job->algorithm, &sub, job->config->quantum,
+                         job->config->horizon, &usage) != 0) {
+        atomic_store(&job->failed, true);
+        return;
+    }
+    job->busy_time[cpu] = usage.busy_time;
+#ifdef PROBSCHED_COUNTERS
+    if (worker > 0) {
+        SimCounters delta;
+        counters_delta(&delta, &sim_counters, &before);
+        counters_merge(&job->worker_counters[worker], &delta);
+    }
+#endif
+
+    for (int k = 0; k < count; k++) {
+        int i = members[k];
+        table->remaining_time[i] = sub.remaining_time[k];
+        table->completion_time[i] = sub.completion_time[k];
+        table->waiting_time[i] = sub.waiting_time[k];
+        table->response_time[i] = sub.response_time[k];
+        table->deadline_misses[i] = sub.deadline_misses[k];
+    }
+}
+
+// A atribuição, as subtabelas e os contextos dos workers vêm da arena de
+// 'ctx'; cada worker simula as suas partições no próprio contexto, cuja
+// arena é esvaziada a cada partição
+static int run_partitioned(SimContext *ctx, Algorithm algorithm, ProcessTable *table,
+                           const MulticoreConfig *config, long long *busy_time) {
+    Arena *arena = &ctx->arena;
+    int n = table->n;
+    int cpus = config->cpus;
+    int threads = (config->threads > 0) ? config->threads : default_thread_count();
+    if (threads > cpus) threads = cpus;
+    int *assignment = arena_alloc_ints(arena, n);
+    int *members = arena_alloc_ints(arena, n);
+    int *offset = arena_alloc_ints(arena, cpus + 1);
+    ProcessTable parts;
+    PartitionJob job = {
+        .algorithm = algorithm,
+        .table = table,
+        .parts = &parts,
+        .config = config,
+        .members = members,
+        .offset = offset,
+        .busy_time = busy_time,
+        .contexts = arena_alloc(arena, threads * sizeof(SimContext))
+    };
+#ifdef PROBSCHED_COUNTERS
+    job.worker_counters = arena_alloc(arena, threads * sizeof(SimCounters));
+    if (!job.worker_counters) return -1;
+    memset(job.worker_counters, 0, threads * sizeof(SimCounters));
+#endif
+    if (!assignment || !members || !offset || !job.contexts ||
+        process_table_init_arena(&parts, n, arena) != 0 ||
+        assign_partitions(algorithm, table, cpus, assignment, arena) != 0) {
+        return -1;
+    }
+
+    // Membros agrupados por CPU (contagem seguida de prefixos)
+    memset(offset, 0, (cpus + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        offset[assignment[i] + 1]++;
+    }
+    for (int cpu = 0; cpu < cpus; cpu++) {
+        offset[cpu + 1] += offset[cpu];
+    }
+    for (int i = 0; i < n; i++) {
+        members[offset[assignment[i]]++] = i;
+    }
+    for (int cpu = cpus; cpu > 0; cpu--) {
+        offset[cpu] = offset[cpu - 1];
+    }
+    offset[0] = 0;
+
+    atomic_init(&job.failed, false);
+    for (int t = 0; t < threads; t++) {
+        sim_context_init(&job.contexts[t]);
+    }
+    parallel_for(cpus, threads, run_partition, &job);
+    for (int t = 0; t < threads; t++) {
+        sim_context_free(&job.contexts[t]);
+    }
+#ifdef PROBSCHED_COUNTERS
+    for (int w = 1; w < threads; w++) {
+        counters_merge(&sim_counters, &job.worker_counters[w]);
+    }
+#endif
+    return atomic_load(&job.failed) ? -1 : 0;
+}
+
+int run_multicore_in(SimContext *ctx, Algorithm algorithm, ProcessTable *table,
+                     const MulticoreConfig *config, long long *busy_time) {
+    // CFS só existe com filas por CPU (como no Linux)
+    if (algorithm == ALG_CFS && config->mode == MULTICORE_GLOBAL) return -1;
+    if (algorithm == ALG_RR && config->quantum <= 0) return -1;
+    arena_reset(&ctx->arena);
+    if (config->mode == MULTICORE_PARTITIONED) {
+        return run_partitioned(ctx, algorithm, table, config, busy_time);
+    }
+    return run_global(algorithm, table, config, busy_time, &ctx->arena);
+}
+
+int run_multicore(Algorithm algorithm, ProcessTable *table, const MulticoreConfig *config,
+                  long long *busy_time) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    int status = run_multicore_in(&ctx, algorithm, table, config, busy_time);
+    sim_context_free(&ctx);
+    return status;
+}
+
+void print_cpu_utilization(const long long *busy_time, int cpus, int total_time) {
+    printf("\n=== Utilização por CPU ===\n\n");
+    printf("%-5s %-12s %-10s\n", "CPU", "Ocupado", "Utilização");
+    printf("-----------------------------\n");
+    for (int cpu = 0; cpu < cpus; cpu++) {
+        double utilization = (total_time > 0) ? (double)busy_time[cpu] / total_time * 100 : 0.0;
+        printf("%-5d %-12lld %.2f%%\n", cpu, busy_time[cpu], utilization);
+    }
+}
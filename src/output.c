@@ -0,0 +1,133 @@
+#include "output.h"
+#include "process.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+static const char *const format_names[] = { "table", "csv", "binary" };
+
+int parse_output_format(const char *name) {
+    for (int i = 0; i < (int)(sizeof(format_names) / sizeof(format_names[0])); i++) {
+        if (strcmp(name, format_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+const char *output_default_path(OutputFormat format) {
+    return (format == OUTPUT_BINARY) ? "resultados.bin" : "resultados.csv";
+}
+
+// Colunas de resultados pela ordem do ficheiro
+static void results_columns(const ProcessTable *table, const int *columns[RESULTS_COLUMNS]) {
+    columns[0] = table->pid;
+    columns[1] = table->arrival_time;
+    columns[2] = table->burst_time;
+    columns[3] = table->priority;
+    columns[4] = table->deadline;
+    columns[5] = table->period;
+    columns[6] = table->completion_time;
+    columns[7] = table->waiting_time;
+    columns[8] = table->deadline_misses;
+    columns[9] = table->response_time;
+}
+
+// O CSV é formatado à mão num buffer grande e escrito num só fwrite por
+// bloco, sem um printf por processo
+#define CSV_BUFFER_SIZE (4 << 20)
+#define CSV_MAX_LINE (RESULTS_COLUMNS * 12 + 1)
+
+static char *append_int(char *out, int value) {
+    char digits[12];
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+    int len = 0;
+    do {
+        digits[len++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) *out++ = '-';
+    while (len > 0) *out++ = digits[--len];
+    return out;
+}
+
+static bool write_csv(const ProcessTable *table, FILE *out) {
+    static const char header[] =
+        "pid,arrival,burst,priority,deadline,period,completion,waiting,deadline_misses,response\n";
+    char *buffer = malloc(CSV_BUFFER_SIZE);
+    if (!buffer) return false;
+
+    const int *columns[RESULTS_COLUMNS];
+    results_columns(table, columns);
+
+    bool ok = fwrite(header, 1, sizeof(header) - 1, out) == sizeof(header) - 1;
+    char *cursor = buffer;
+    for (int i = 0; ok && i < table->n; i++) {
+        if (cursor - buffer > CSV_BUFFER_SIZE - CSV_MAX_LINE) {
+            ok = fwrite(buffer, 1, cursor - buffer, out) == (size_t)(cursor - buffer);
+            cursor = buffer;
+        }
+        for (int c = 0; c < RESULTS_COLUMNS; c++) {
+            cursor = append_int(cursor, columns[c][i]);
+            *cursor++ = (c + 1 < RESULTS_COLUMNS) ? ',' : '\n';
+        }
+    }
+    if (ok && cursor > buffer) {
+        ok = fwrite(buffer, 1, cursor - buffer, out) == (size_t)(cursor - buffer);
+    }
+    free(buffer);
+    return ok;
+}
+
+static uint64_t align_up(uint64_t value) {
+    return (value + RESULTS_ALIGN - 1) / RESULTS_ALIGN * RESULTS_ALIGN;
+}
+
+// As colunas da tabela são escritas tal como estão em memória
+static bool write_binary(const ProcessTable *table, FILE *out) {
+    static const char padding[RESULTS_ALIGN];
+    uint64_t count = (uint64_t)table->n;
+    ResultsHeader header = {
+        .magic = RESULTS_MAGIC,
+        .version = RESULTS_VERSION,
+        .columns = RESULTS_COLUMNS,
+        .count = count
+    };
+    uint64_t offset = align_up(sizeof(header));
+    for (int c = 0; c < RESULTS_COLUMNS; c++) {
+        header.column_offset[c] = offset;
+        offset += align_up(count * sizeof(int32_t));
+    }
+
+    const int *columns[RESULTS_COLUMNS];
+    results_columns(table, columns);
+
+    size_t header_padding = align_up(sizeof(header)) - sizeof(header);
+    if (fwrite(&header, sizeof(header), 1, out) != 1 ||
+        fwrite(padding, 1, header_padding, out) != header_padding) {
+        return false;
+    }
+    size_t column_padding = align_up(count * sizeof(int32_t)) - count * sizeof(int32_t);
+    for (int c = 0; c < RESULTS_COLUMNS; c++) {
+        if (fwrite(columns[c], sizeof(int32_t), count, out) != count ||
+            fwrite(padding, 1, column_padding, out) != column_padding) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int write_results(const ProcessTable *table, OutputFormat format, const char *path) {
+    FILE *out = fopen(path, "wb");
+    if (!out) {
+        perror(path);
+        return -1;
+    }
+
+    bool ok = (format == OUTPUT_BINARY) ? write_binary(table, out) : write_csv(table, out);
+    if (fclose(out) != 0) ok = false;
+    if (!ok) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
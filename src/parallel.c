@@ -0,0 +1,71 @@
+#include "parallel.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct {
+    atomic_int next;
+    int count;
+    ParallelTask task;
+    void *arg;
+} ParallelJob;
+
+typedef struct {
+    ParallelJob *job;
+    int worker;
+} WorkerArgs;
+
+static void *worker_loop(void *arg) {
+    WorkerArgs *args = (WorkerArgs *)arg;
+    ParallelJob *job = args->job;
+    for (;;) {
+        int index = atomic_fetch_add(&job->next, 1);
+        if (index >= job->count) break;
+        job->task(index, args->worker, job->arg);
+    }
+    return NULL;
+}
+
+void parallel_for(int count, int threads, ParallelTask task, void *arg) {
+    if (threads > count) threads = count;
+    if (threads < 1) threads = 1;
+
+    ParallelJob job = { .count = count, .task = task, .arg = arg };
+    atomic_init(&job.next, 0);
+
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    WorkerArgs *args = malloc(threads * sizeof(WorkerArgs));
+    bool *launched = calloc(threads, sizeof(bool));
+    if (!workers || !args || !launched) {
+        // Sem memória para as threads: executa tudo na thread chamadora
+        WorkerArgs self = { &job, 0 };
+        worker_loop(&self);
+        free(workers);
+        free(args);
+        free(launched);
+        return;
+    }
+
+    for (int t = 0; t < threads; t++) {
+        args[t].job = &job;
+        args[t].worker = t;
+        if (t > 0) {
+            launched[t] = pthread_create(&workers[t], NULL, worker_loop, &args[t]) == 0;
+        }
+    }
+    worker_loop(&args[0]);
+    for (int t = 1; t < threads; t++) {
+        if (launched[t]) pthread_join(workers[t], NULL);
+    }
+
+    free(workers);
+    free(args);
+    free(launched);
+}
+
+int default_thread_count(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cpus > 1) ? (int)cpus : 1;
+}
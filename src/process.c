@@ -1,47 +1,239 @@
 #include "process.h"
 #include "distributions.h"
+#include "rng.h"
+#include "ready_queue.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
 
-Process *generate_processes(int n, bool real_time) {
-    Process *processes = malloc(n * sizeof(Process));
-    if (!processes) {
-        perror("Erro ao alocar memória para processos");
-        exit(EXIT_FAILURE);
-    }
-
-    for (int i = 0; i < n; i++) {
-        processes[i].pid = i + 1;
-        processes[i].arrival_time = poisson_distribution(5);
-        processes[i].burst_time = normal_distribution(5, 3);
-        processes[i].priority = uniform_distribution(1, 10);
-        processes[i].deadline = uniform_distribution(1, 10);
-        processes[i].remaining_time = processes[i].burst_time;
-        processes[i].completion_time = 0;  
-        processes[i].waiting_time = 0;     
-        processes[i].deadline_misses = 0;
-        
-        if (real_time) {
-            processes[i].period = normal_distribution(5, 3);
-            processes[i].deadline = processes[i].arrival_time + processes[i].period;
-        } else {
-            processes[i].deadline = 0;
-            processes[i].period = 0;
-        }
-    }
+// Abaixo deste tamanho não compensa repartir a geração por threads
+#define PARALLEL_GENERATION_MIN 65536
+#define MAX_GENERATION_THREADS 16
+
+// Atributos comuns a todos os geradores, a partir do substream do processo
+static void generate_attributes(Process *process, Rng *rng, bool real_time) {
+    process->burst_time = normal_distribution(rng, 5, 3);
+    process->priority = uniform_distribution(rng, 1, 10);
+    process->deadline = uniform_distribution(rng, 1, 10);
+    process->remaining_time = process->burst_time;
+    process->completion_time = 0;  
+    process->waiting_time = 0;     
+    process->response_time = 0;
+    process->deadline_misses = 0;
     
-    return processes;
+    if (real_time) {
+        process->period = normal_distribution(rng, 5, 3);
+        process->deadline = process->arrival_time + process->period;
+    } else {
+        process->deadline = 0;
+        process->period = 0;
+    }
+}
+
+void generate_process(Process *process, int index, bool real_time, uint64_t seed) {
+    // Substream próprio por processo: os atributos de i dependem apenas de (seed, i)
+    Rng rng;
+    rng_init(&rng, seed, (uint64_t)index);
+
+    process->pid = index + 1;
+    process->arrival_time = poisson_distribution(&rng, 5);
+    generate_attributes(process, &rng, real_time);
 }
 
-void free_processes(Process *processes) {
-    free(processes);
+void generate_stream_process(Process *process, int index, int previous_arrival,
+                             double mean_interarrival, uint64_t seed) {
+    Rng rng;
+    rng_init(&rng, seed, (uint64_t)index);
+
+    process->pid = index + 1;
+    process->arrival_time = previous_arrival + poisson_distribution(&rng, mean_interarrival);
+    generate_attributes(process, &rng, false);
 }
 
-void reset_processes(Process *processes, int n) {
-    for (int i = 0; i < n; i++) {
-        processes[i].remaining_time = processes[i].burst_time;
-        processes[i].completion_time = -1;
-        processes[i].waiting_time = 0;
+// Colunas de entrada e de estado por bloco, pela ordem dos campos de ProcessTable
+#define INPUT_COLUMNS 6
+#define STATE_COLUMNS 5
+
+int process_table_init(ProcessTable *table, int n) {
+    if (process_table_init_state(table, n) != 0) return -1;
+    table->columns = malloc((size_t)n * INPUT_COLUMNS * sizeof(int));
+    if (!table->columns) {
+        process_table_free(table);
+        return -1;
     }
+
+    table->pid = table->columns;
+    table->arrival_time = table->pid + n;
+    table->burst_time = table->arrival_time + n;
+    table->priority = table->burst_time + n;
+    table->deadline = table->priority + n;
+    table->period = table->deadline + n;
+    return 0;
+}
+
+int process_table_init_state(ProcessTable *table, int n) {
+    memset(table, 0, sizeof(*table));
+    table->state = calloc((size_t)n * STATE_COLUMNS, sizeof(int));
+    if (!table->state) return -1;
+
+    table->n = n;
+    table->remaining_time = table->state;
+    table->completion_time = table->remaining_time + n;
+    table->waiting_time = table->completion_time + n;
+    table->response_time = table->waiting_time + n;
+    table->deadline_misses = table->response_time + n;
+    return 0;
+}
+
+int process_table_init_arena(ProcessTable *table, int n, Arena *arena) {
+    memset(table, 0, sizeof(*table));
+    size_t count = (size_t)(n > 0 ? n : 1) * (INPUT_COLUMNS + STATE_COLUMNS);
+    int *columns = arena_alloc(arena, count * sizeof(int));
+    if (!columns) return -1;
+    memset(columns, 0, count * sizeof(int));
+
+    table->n = n;
+    table->pid = columns;
+    table->arrival_time = table->pid + n;
+    table->burst_time = table->arrival_time + n;
+    table->priority = table->burst_time + n;
+    table->deadline = table->priority + n;
+    table->period = table->deadline + n;
+    table->remaining_time = table->period + n;
+    table->completion_time = table->remaining_time + n;
+    table->waiting_time = table->completion_time + n;
+    table->response_time = table->waiting_time + n;
+    table->deadline_misses = table->response_time + n;
+    return 0;
+}
+
+int process_table_init_view(ProcessTable *view, const ProcessTable *source) {
+    if (process_table_init_state(view, source->n) != 0) return -1;
+    view->pid = source->pid;
+    view->arrival_time = source->arrival_time;
+    view->burst_time = source->burst_time;
+    view->priority = source->priority;
+    view->deadline = source->deadline;
+    view->period = source->period;
+    view->arrival_order = source->arrival_order;
+    view->borrowed = true;
+    return 0;
+}
+
+void process_table_free(ProcessTable *table) {
+    free(table->columns);
+    free(table->state);
+    if (!table->borrowed) free(table->arrival_order);
+    memset(table, 0, sizeof(*table));
+}
+
+void process_table_get(const ProcessTable *table, int i, Process *process) {
+    process->pid = table->pid[i];
+    process->arrival_time = table->arrival_time[i];
+    process->burst_time = table->burst_time[i];
+    process->remaining_time = table->remaining_time[i];
+    process->priority = table->priority[i];
+    process->deadline = table->deadline[i];
+    process->period = table->period[i];
+    process->completion_time = table->completion_time[i];
+    process->waiting_time = table->waiting_time[i];
+    process->response_time = table->response_time[i];
+    process->deadline_misses = table->deadline_misses[i];
+}
+
+void process_table_set(ProcessTable *table, int i, const Process *process) {
+    table->pid[i] = process->pid;
+    table->arrival_time[i] = process->arrival_time;
+    table->burst_time[i] = process->burst_time;
+    table->remaining_time[i] = process->remaining_time;
+    table->priority[i] = process->priority;
+    table->deadline[i] = process->deadline;
+    table->period[i] = process->period;
+    table->completion_time[i] = process->completion_time;
+    table->waiting_time[i] = process->waiting_time;
+    table->response_time[i] = process->response_time;
+    table->deadline_misses[i] = process->deadline_misses;
+}
+
+void process_table_reset(ProcessTable *table) {
+    for (int i = 0; i < table->n; i++) {
+        table->remaining_time[i] = table->burst_time[i];
+        table->completion_time[i] = 0;
+        table->waiting_time[i] = 0;
+        table->response_time[i] = 0;
+        table->deadline_misses[i] = 0;
+    }
+}
+
+int process_table_index_arrivals(ProcessTable *table) {
+    if (table->arrival_order) return 0;
+    int *order = malloc((table->n > 0 ? table->n : 1) * sizeof(int));
+    if (!order) return -1;
+    if (sort_index_by_key(table->arrival_time, table->n, order) != 0) {
+        free(order);
+        return -1;
+    }
+    table->arrival_order = order;
+    return 0;
+}
+
+typedef struct {
+    ProcessTable *table;
+    int start;
+    int end;
+    bool real_time;
+    uint64_t seed;
+} GenerationRange;
+
+static void *generate_range(void *arg) {
+    GenerationRange *range = (GenerationRange *)arg;
+    Process process;
+    for (int i = range->start; i < range->end; i++) {
+        generate_process(&process, i, range->real_time, range->seed);
+        process_table_set(range->table, i, &process);
+    }
+    return NULL;
+}
+
+void generate_processes(ProcessTable *table, bool real_time, uint64_t seed) {
+    int n = table->n;
+    free(table->arrival_order);
+    table->arrival_order = NULL;
+
+    // Como cada processo tem o seu substream, a divisão em blocos por threads
+    // produz exatamente o mesmo resultado que a geração sequencial
+    int threads = 1;
+    if (n >= PARALLEL_GENERATION_MIN) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 1) ? (int)cpus : 1;
+        if (threads > MAX_GENERATION_THREADS) threads = MAX_GENERATION_THREADS;
+    }
+
+    pthread_t workers[MAX_GENERATION_THREADS];
+    GenerationRange ranges[MAX_GENERATION_THREADS];
+    bool launched[MAX_GENERATION_THREADS] = { false };
+    for (int t = 0; t < threads; t++) {
+        ranges[t] = (GenerationRange){ table, (int)((long long)n * t / threads),
+                                       (int)((long long)n * (t + 1) / threads), real_time, seed };
+        if (t > 0) {
+            launched[t] = pthread_create(&workers[t], NULL, generate_range, &ranges[t]) == 0;
+        }
+    }
+    generate_range(&ranges[0]);
+    for (int t = 1; t < threads; t++) {
+        if (launched[t]) {
+            pthread_join(workers[t], NULL);
+        } else {
+            generate_range(&ranges[t]);
+        }
+    }
+}
+
+int process_relative_deadline(const ProcessTable *table, int i) {
+    int relative = table->deadline[i] - table->arrival_time[i];
+    return (relative > 0) ? relative : table->period[i];
 }
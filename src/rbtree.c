@@ -0,0 +1,273 @@
+#include "rbtree.h"
+#include "counters.h"
+#include <stdlib.h>
+
+// Implementação clássica (Cormen et al.) com sentinela: o nó 'nil' é preto e
+// os seus campos podem ser escritos durante as correções da remoção
+
+static void rb_tree_setup(RbTree *t, int capacity) {
+    t->capacity = capacity;
+    t->root = capacity;
+    t->leftmost = -1;
+    t->size = 0;
+    t->red[capacity] = false;
+    t->left[capacity] = t->right[capacity] = t->parent[capacity] = capacity;
+}
+
+int rb_tree_init(RbTree *t, int capacity) {
+    int nodes = capacity + 1;
+    t->left = malloc(nodes * sizeof(int));
+    t->right = malloc(nodes * sizeof(int));
+    t->parent = malloc(nodes * sizeof(int));
+    t->red = malloc(nodes * sizeof(bool));
+    t->key = malloc(nodes * sizeof(long long));
+    if (!t->left || !t->right || !t->parent || !t->red || !t->key) {
+        rb_tree_free(t);
+        return -1;
+    }
+    rb_tree_setup(t, capacity);
+    return 0;
+}
+
+int rb_tree_init_arena(RbTree *t, int capacity, Arena *arena) {
+    int nodes = capacity + 1;
+    t->left = arena_alloc_ints(arena, nodes);
+    t->right = arena_alloc_ints(arena, nodes);
+    t->parent = arena_alloc_ints(arena, nodes);
+    t->red = arena_alloc(arena, nodes * sizeof(bool));
+    t->key = arena_alloc(arena, nodes * sizeof(long long));
+    if (!t->left || !t->right || !t->parent || !t->red || !t->key) return -1;
+    rb_tree_setup(t, capacity);
+    return 0;
+}
+
+void rb_tree_free(RbTree *t) {
+    free(t->left);
+    free(t->right);
+    free(t->parent);
+    free(t->red);
+    free(t->key);
+    t->left = t->right = t->parent = NULL;
+    t->red = NULL;
+    t->key = NULL;
+    t->size = t->capacity = 0;
+    t->leftmost = -1;
+}
+
+// a precede b? (chave menor; em empate, menor índice)
+static inline bool precedes(const RbTree *t, int a, int b) {
+    if (t->key[a] != t->key[b]) return t->key[a] < t->key[b];
+    return a < b;
+}
+
+static void rotate_left(RbTree *t, int x) {
+    int nil = t->capacity;
+    int y = t->right[x];
+    t->right[x] = t->left[y];
+    if (t->left[y] != nil) t->parent[t->left[y]] = x;
+    t->parent[y] = t->parent[x];
+    if (t->parent[x] == nil) {
+        t->root = y;
+    } else if (x == t->left[t->parent[x]]) {
+        t->left[t->parent[x]] = y;
+    } else {
+        t->right[t->parent[x]] = y;
+    }
+    t->left[y] = x;
+    t->parent[x] = y;
+}
+
+static void rotate_right(RbTree *t, int x) {
+    int nil = t->capacity;
+    int y = t->left[x];
+    t->left[x] = t->right[y];
+    if (t->right[y] != nil) t->parent[t->right[y]] = x;
+    t->parent[y] = t->parent[x];
+    if (t->parent[x] == nil) {
+        t->root = y;
+    } else if (x == t->right[t->parent[x]]) {
+        t->right[t->parent[x]] = y;
+    } else {
+        t->left[t->parent[x]] = y;
+    }
+    t->right[y] = x;
+    t->parent[x] = y;
+}
+
+void rb_tree_insert(RbTree *t, int id, long long key) {
+    COUNTER_INC(queue_operations);
+    int nil = t->capacity;
+    t->key[id] = key;
+    t->left[id] = t->right[id] = nil;
+    t->red[id] = true;
+
+    int parent = nil;
+    int node = t->root;
+    while (node != nil) {
+        COUNTER_INC(sift_steps);
+        parent = node;
+        node = precedes(t, id, node) ? t->left[node] : t->right[node];
+    }
+    t->parent[id] = parent;
+    if (parent == nil) {
+        t->root = id;
+    } else if (precedes(t, id, parent)) {
+        t->left[parent] = id;
+    } else {
+        t->right[parent] = id;
+    }
+    if (t->leftmost < 0 || precedes(t, id, t->leftmost)) t->leftmost = id;
+    t->size++;
+
+    // Repõe as propriedades: nenhum nó vermelho com pai vermelho
+    int z = id;
+    while (t->red[t->parent[z]]) {
+        int p = t->parent[z];
+        int g = t->parent[p];
+        if (p == t->left[g]) {
+            int uncle = t->right[g];
+            if (t->red[uncle]) {
+                t->red[p] = t->red[uncle] = false;
+                t->red[g] = true;
+                z = g;
+            } else {
+                if (z == t->right[p]) {
+                    z = p;
+                    rotate_left(t, z);
+                    p = t->parent[z];
+                }
+                t->red[p] = false;
+                t->red[g] = true;
+                rotate_right(t, g);
+            }
+        } else {
+            int uncle = t->left[g];
+            if (t->red[uncle]) {
+                t->red[p] = t->red[uncle] = false;
+                t->red[g] = true;
+                z = g;
+            } else {
+                if (z == t->left[p]) {
+                    z = p;
+                    rotate_right(t, z);
+                    p = t->parent[z];
+                }
+                t->red[p] = false;
+                t->red[g] = true;
+                rotate_left(t, g);
+            }
+        }
+    }
+    t->red[t->root] = false;
+}
+
+static int subtree_minimum(const RbTree *t, int node) {
+    while (t->left[node] != t->capacity) node = t->left[node];
+    return node;
+}
+
+// Substitui a subárvore u pela subárvore v
+static void transplant(RbTree *t, int u, int v) {
+    if (t->parent[u] == t->capacity) {
+        t->root = v;
+    } else if (u == t->left[t->parent[u]]) {
+        t->left[t->parent[u]] = v;
+    } else {
+        t->right[t->parent[u]] = v;
+    }
+    t->parent[v] = t->parent[u];
+}
+
+void rb_tree_remove(RbTree *t, int z) {
+    COUNTER_INC(queue_operations);
+    int nil = t->capacity;
+
+    // O sucessor do mínimo é o mínimo da subárvore direita ou o pai
+    if (z == t->leftmost) {
+        t->leftmost = (t->right[z] != nil) ? subtree_minimum(t, t->right[z]) : t->parent[z];
+        if (t->leftmost == nil) t->leftmost = -1;
+    }
+
+    int y = z;
+    bool removed_red = t->red[y];
+    int x;
+    if (t->left[z] == nil) {
+        x = t->right[z];
+        transplant(t, z, t->right[z]);
+    } else if (t->right[z] == nil) {
+        x = t->left[z];
+        transplant(t, z, t->left[z]);
+    } else {
+        y = subtree_minimum(t, t->right[z]);
+        removed_red = t->red[y];
+        x = t->right[y];
+        if (t->parent[y] == z) {
+            t->parent[x] = y;
+        } else {
+            transplant(t, y, t->right[y]);
+            t->right[y] = t->right[z];
+            t->parent[t->right[y]] = y;
+        }
+        transplant(t, z, y);
+        t->left[y] = t->left[z];
+        t->parent[t->left[y]] = y;
+        t->red[y] = t->red[z];
+    }
+    t->size--;
+    if (removed_red) return;
+
+    // Remoção de um nó preto: redistribui o preto em falta a partir de x
+    while (x != t->root && !t->red[x]) {
+        int p = t->parent[x];
+        if (x == t->left[p]) {
+            int w = t->right[p];
+            if (t->red[w]) {
+                t->red[w] = false;
+                t->red[p] = true;
+                rotate_left(t, p);
+                w = t->right[p];
+            }
+            if (!t->red[t->left[w]] && !t->red[t->right[w]]) {
+                t->red[w] = true;
+                x = p;
+            } else {
+                if (!t->red[t->right[w]]) {
+                    t->red[t->left[w]] = false;
+                    t->red[w] = true;
+                    rotate_right(t, w);
+                    w = t->right[p];
+                }
+                t->red[w] = t->red[p];
+                t->red[p] = false;
+                t->red[t->right[w]] = false;
+                rotate_left(t, p);
+                x = t->root;
+            }
+        } else {
+            int w = t->left[p];
+            if (t->red[w]) {
+                t->red[w] = false;
+                t->red[p] = true;
+                rotate_right(t, p);
+                w = t->left[p];
+            }
+            if (!t->red[t->right[w]] && !t->red[t->left[w]]) {
+                t->red[w] = true;
+                x = p;
+            } else {
+                if (!t->red[t->left[w]]) {
+                    t->red[t->right[w]] = false;
+                    t->red[w] = true;
+                    rotate_left(t, w);
+                    w = t->left[p];
+                }
+                t->red[w] = t->red[p];
+                t->red[p] = false;
+                t->red[t->left[w]] = false;
+                rotate_right(t, p);
+                x = t->root;
+            }
+        }
+    }
+    t->red[x] = false;
+}
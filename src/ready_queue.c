@@ -0,0 +1,371 @@
+#include "ready_queue.h"
+#include "process.h"
+#include "counters.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+static void ready_queue_setup(ReadyQueue *q, int capacity) {
+    q->tiebreak = NULL;
+    q->size = 0;
+    q->capacity = capacity;
+    for (int i = 0; i < capacity; i++) {
+        q->pos[i] = -1;
+    }
+}
+
+int ready_queue_init(ReadyQueue *q, int capacity) {
+    q->heap = malloc(capacity * sizeof(int));
+    q->pos = malloc(capacity * sizeof(int));
+    q->key = malloc(capacity * sizeof(int));
+    if (!q->heap || !q->pos || !q->key) {
+        ready_queue_free(q);
+        return -1;
+    }
+    ready_queue_setup(q, capacity);
+    return 0;
+}
+
+int ready_queue_init_arena(ReadyQueue *q, int capacity, Arena *arena) {
+    q->heap = arena_alloc_ints(arena, capacity);
+    q->pos = arena_alloc_ints(arena, capacity);
+    q->key = arena_alloc_ints(arena, capacity);
+    if (!q->heap || !q->pos || !q->key) return -1;
+    ready_queue_setup(q, capacity);
+    return 0;
+}
+
+void ready_queue_free(ReadyQueue *q) {
+    free(q->heap);
+    free(q->pos);
+    free(q->key);
+    q->heap = q->pos = q->key = NULL;
+    q->size = q->capacity = 0;
+}
+
+int ready_queue_reserve(ReadyQueue *q, int capacity) {
+    if (capacity <= q->capacity) return 0;
+    int *heap = realloc(q->heap, capacity * sizeof(int));
+    if (heap) q->heap = heap;
+    int *pos = realloc(q->pos, capacity * sizeof(int));
+    if (pos) q->pos = pos;
+    int *key = realloc(q->key, capacity * sizeof(int));
+    if (key) q->key = key;
+    if (!heap || !pos || !key) return -1;
+
+    for (int i = q->capacity; i < capacity; i++) {
+        q->pos[i] = -1;
+    }
+    q->capacity = capacity;
+    return 0;
+}
+
+int ready_queue_reserve_arena(ReadyQueue *q, int capacity, Arena *arena) {
+    if (capacity <= q->capacity) return 0;
+    int *heap = arena_alloc_ints(arena, capacity);
+    int *pos = arena_alloc_ints(arena, capacity);
+    int *key = arena_alloc_ints(arena, capacity);
+    if (!heap || !pos || !key) return -1;
+    memcpy(heap, q->heap, q->size * sizeof(int));
+    memcpy(pos, q->pos, q->capacity * sizeof(int));
+    memcpy(key, q->key, q->capacity * sizeof(int));
+
+    for (int i = q->capacity; i < capacity; i++) {
+        pos[i] = -1;
+    }
+    q->heap = heap;
+    q->pos = pos;
+    q->key = key;
+    q->capacity = capacity;
+    return 0;
+}
+
+void ready_queue_clear(ReadyQueue *q) {
+    for (int i = 0; i < q->size; i++) {
+        q->pos[q->heap[i]] = -1;
+    }
+    q->size = 0;
+}
+
+// a precede b? (chave menor; em empate, menor desempate/índice)
+static inline bool precedes(const ReadyQueue *q, int a, int b) {
+    if (q->key[a] != q->key[b]) return q->key[a] < q->key[b];
+    if (q->tiebreak && q->tiebreak[a] != q->tiebreak[b]) return q->tiebreak[a] < q->tiebreak[b];
+    return a < b;
+}
+
+static void sift_up(ReadyQueue *q, int i) {
+    int id = q->heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!precedes(q, id, q->heap[parent])) break;
+        COUNTER_INC(sift_steps);
+        q->heap[i] = q->heap[parent];
+        q->pos[q->heap[i]] = i;
+        i = parent;
+    }
+    q->heap[i] = id;
+    q->pos[id] = i;
+}
+
+static void sift_down(ReadyQueue *q, int i) {
+    int id = q->heap[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= q->size) break;
+        if (child + 1 < q->size && precedes(q, q->heap[child + 1], q->heap[child])) {
+            child++;
+        }
+        if (!precedes(q, q->heap[child], id)) break;
+        COUNTER_INC(sift_steps);
+        q->heap[i] = q->heap[child];
+        q->pos[q->heap[i]] = i;
+        i = child;
+    }
+    q->heap[i] = id;
+    q->pos[id] = i;
+}
+
+void ready_queue_push(ReadyQueue *q, int id, int key) {
+    COUNTER_INC(queue_operations);
+    q->key[id] = key;
+    q->heap[q->size] = id;
+    q->pos[id] = q->size;
+    q->size++;
+    sift_up(q, q->size - 1);
+}
+
+void ready_queue_update(ReadyQueue *q, int id, int key) {
+    if (q->pos[id] < 0) {
+        ready_queue_push(q, id, key);
+        return;
+    }
+    COUNTER_INC(queue_operations);
+    int old = q->key[id];
+    q->key[id] = key;
+    if (key < old) {
+        sift_up(q, q->pos[id]);
+    } else {
+        sift_down(q, q->pos[id]);
+    }
+}
+
+void ready_queue_remove(ReadyQueue *q, int id) {
+    int i = q->pos[id];
+    if (i < 0) return;
+    COUNTER_INC(queue_operations);
+    q->pos[id] = -1;
+    q->size--;
+    if (i == q->size) return;
+
+    // O último elemento ocupa o lugar do removido e é reposicionado
+    int moved = q->heap[q->size];
+    q->heap[i] = moved;
+    q->pos[moved] = i;
+    sift_up(q, i);
+    if (q->pos[moved] == i) sift_down(q, i);
+}
+
+int ready_queue_pop(ReadyQueue *q) {
+    if (q->size == 0) return -1;
+    int id = q->heap[0];
+    ready_queue_remove(q, id);
+    return id;
+}
+
+int fifo_queue_init(FifoQueue *q, int capacity) {
+    if (capacity < 1) capacity = 1;
+    q->items = malloc(capacity * sizeof(int));
+    q->head = 0;
+    q->size = 0;
+    q->capacity = q->items ? capacity : 0;
+    return q->items ? 0 : -1;
+}
+
+int fifo_queue_init_arena(FifoQueue *q, int capacity, Arena *arena) {
+    if (capacity < 1) capacity = 1;
+    q->items = arena_alloc_ints(arena, capacity);
+    q->head = 0;
+    q->size = 0;
+    q->capacity = q->items ? capacity : 0;
+    return q->items ? 0 : -1;
+}
+
+int fifo_queue_reserve_arena(FifoQueue *q, int capacity, Arena *arena) {
+    if (capacity <= q->capacity) return 0;
+    int *items = arena_alloc_ints(arena, capacity);
+    if (!items) return -1;
+    // Desenrola o anel para o início do novo buffer
+    for (int i = 0; i < q->size; i++) {
+        items[i] = q->items[(q->head + i) % q->capacity];
+    }
+    q->items = items;
+    q->head = 0;
+    q->capacity = capacity;
+    return 0;
+}
+
+void fifo_queue_free(FifoQueue *q) {
+    free(q->items);
+    q->items = NULL;
+    q->head = q->size = q->capacity = 0;
+}
+
+int fifo_queue_push(FifoQueue *q, int id) {
+    if (q->size == q->capacity) {
+        // Duplica e desenrola o anel para o início do novo buffer
+        int new_capacity = q->capacity ? 2 * q->capacity : 16;
+        int *items = malloc(new_capacity * sizeof(int));
+        if (!items) return -1;
+        for (int i = 0; i < q->size; i++) {
+            items[i] = q->items[(q->head + i) % q->capacity];
+        }
+        free(q->items);
+        q->items = items;
+        q->head = 0;
+        q->capacity = new_capacity;
+    }
+    int tail = q->head + q->size;
+    if (tail >= q->capacity) tail -= q->capacity;
+    q->items[tail] = id;
+    q->size++;
+    return 0;
+}
+
+int fifo_queue_pop(FifoQueue *q) {
+    if (q->size == 0) return -1;
+    int id = q->items[q->head];
+    if (++q->head == q->capacity) q->head = 0;
+    q->size--;
+    return id;
+}
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+// Memória auxiliar da ordenação: da arena, se houver, ou do heap
+static int *scratch_alloc(Arena *arena, size_t count) {
+    return arena ? arena_alloc(arena, count * sizeof(int)) : malloc(count * sizeof(int));
+}
+
+static void scratch_free(Arena *arena, int *scratch) {
+    if (!arena) free(scratch);
+}
+
+static int sort_index(const int *key, int n, int *order, Arena *arena) {
+    if (n <= 0) return 0;
+    int min = key[0], max = key[0];
+    for (int i = 1; i < n; i++) {
+        if (key[i] < min) min = key[i];
+        if (key[i] > max) max = key[i];
+    }
+    // As chaves são deslocadas para [0, range] em aritmética sem sinal
+    unsigned range = (unsigned)max - (unsigned)min;
+
+    // Intervalo pequeno (caso típico das chegadas): uma passagem de contagem
+    if (range < (unsigned)n + RADIX_BUCKETS) {
+        int *count = scratch_alloc(arena, (size_t)range + 2);
+        if (!count) return -1;
+        memset(count, 0, ((size_t)range + 2) * sizeof(int));
+        for (int i = 0; i < n; i++) {
+            count[(unsigned)key[i] - (unsigned)min + 1]++;
+        }
+        for (unsigned b = 0; b <= range; b++) {
+            count[b + 1] += count[b];
+        }
+        for (int i = 0; i < n; i++) {
+            order[count[(unsigned)key[i] - (unsigned)min]++] = i;
+        }
+        scratch_free(arena, count);
+        return 0;
+    }
+
+    // Radix LSD: só os dígitos presentes no intervalo, cada passagem estável
+    int *buffer = scratch_alloc(arena, n);
+    if (!buffer) return -1;
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    int *src = order, *dst = buffer;
+    for (unsigned shift = 0; shift < 32 && (range >> shift) != 0; shift += RADIX_BITS) {
+        int count[RADIX_BUCKETS + 1] = {0};
+        for (int k = 0; k < n; k++) {
+            count[(((unsigned)key[src[k]] - (unsigned)min) >> shift & (RADIX_BUCKETS - 1)) + 1]++;
+        }
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            count[b + 1] += count[b];
+        }
+        for (int k = 0; k < n; k++) {
+            unsigned digit = ((unsigned)key[src[k]] - (unsigned)min) >> shift & (RADIX_BUCKETS - 1);
+            dst[count[digit]++] = src[k];
+        }
+        int *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != order) memcpy(order, src, n * sizeof(int));
+    scratch_free(arena, buffer);
+    return 0;
+}
+
+int sort_index_by_key(const int *key, int n, int *order) {
+    return sort_index(key, n, order, NULL);
+}
+
+int sort_index_by_key_arena(const int *key, int n, int *order, Arena *arena) {
+    return sort_index(key, n, order, arena);
+}
+
+int arrival_cursor_init(ArrivalCursor *c, const int *arrival_time, int n) {
+    int *order = malloc((n > 0 ? n : 1) * sizeof(int));
+    c->order = order;
+    c->arrival_time = arrival_time;
+    c->n = n;
+    c->next = 0;
+    c->owns_order = true;
+    if (!order || sort_index_by_key(arrival_time, n, order) != 0) {
+        arrival_cursor_free(c);
+        return -1;
+    }
+    return 0;
+}
+
+int arrival_cursor_open(ArrivalCursor *c, const ProcessTable *table) {
+    if (!table->arrival_order) {
+        return arrival_cursor_init(c, table->arrival_time, table->n);
+    }
+    c->order = table->arrival_order;
+    c->arrival_time = table->arrival_time;
+    c->n = table->n;
+    c->next = 0;
+    c->owns_order = false;
+    return 0;
+}
+
+int arrival_cursor_open_arena(ArrivalCursor *c, const ProcessTable *table, Arena *arena) {
+    if (table->arrival_order) return arrival_cursor_open(c, table);
+    int *order = arena_alloc_ints(arena, table->n);
+    c->order = order;
+    c->arrival_time = table->arrival_time;
+    c->n = table->n;
+    c->next = 0;
+    c->owns_order = false;
+    if (!order || sort_index(table->arrival_time, table->n, order, arena) != 0) return -1;
+    return 0;
+}
+
+void arrival_cursor_free(ArrivalCursor *c) {
+    if (c->owns_order) free((int *)c->order);
+    c->order = NULL;
+    c->owns_order = false;
+}
+
+int arrival_cursor_peek_time(const ArrivalCursor *c) {
+    if (c->next >= c->n) return INT_MAX;
+    return c->arrival_time[c->order[c->next]];
+}
+
+int arrival_cursor_next(ArrivalCursor *c, int now) {
+    if (c->next >= c->n || c->arrival_time[c->order[c->next]] > now) return -1;
+    return c->order[c->next++];
+}
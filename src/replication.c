@@ -0,0 +1,86 @@
+#include "replication.h"
+#include "analysis.h"
+#include "parallel.h"
+#include "process.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Estado privado de cada worker: tabela de processos e contexto de simulação
+// reutilizados entre replicações e acumulador local, combinado no fim
+typedef struct {
+    ProcessTable table;
+    SimContext context;
+    StatsAccumulator acc;
+    bool failed;            // Alguma replicação ficou sem memória
+} ReplicationWorker;
+
+typedef struct {
+    const ReplicationConfig *config;
+    ReplicationWorker *workers;
+} ReplicationJob;
+
+static void run_replication(int index, int worker, void *arg) {
+    ReplicationJob *job = (ReplicationJob *)arg;
+    const ReplicationConfig *config = job->config;
+    ReplicationWorker *state = &job->workers[worker];
+    int n = config->num_processes;
+
+    ProcessTable *table = &state->table;
+
+    if (!table->columns && process_table_init(table, n) != 0) {
+        perror("Erro ao alocar memória para processos");
+        exit(EXIT_FAILURE);
+    }
+
+    // Geração sequencial: o paralelismo já está nas replicações
+    bool real_time = algorithm_is_real_time(config->algorithm);
+    uint64_t seed = rng_derive_seed(config->seed, (uint64_t)index);
+    Process process;
+    for (int i = 0; i < n; i++) {
+        generate_process(&process, i, real_time, seed);
+        process_table_set(table, i, &process);
+    }
+
+    int horizon = 0;
+    if (real_time) {
+        bool truncated;
+        horizon = simulation_horizon(table, config->horizon_cap, &truncated);
+    }
+
+    Trace usage;
+    trace_init_summary(&usage);
+    if (run_algorithm_in(&state->context, config->algorithm, table, config->quantum, horizon,
+                         &usage) != 0) {
+        state->failed = true;
+        return;
+    }
+
+    stats_accumulator_add(&state->acc, algorithm_stats(config->algorithm, table, horizon,
+                                                       &usage.busy_time, 1));
+    latency_histograms_add_table(&state->acc.latency, table);
+}
+
+int run_replications(const ReplicationConfig *config, StatsAccumulator *result) {
+    int threads = (config->threads > 0) ? config->threads : default_thread_count();
+    ReplicationWorker *workers = calloc(threads, sizeof(ReplicationWorker));
+    if (!workers) return -1;
+    for (int t = 0; t < threads; t++) {
+        sim_context_init(&workers[t].context);
+    }
+
+    ReplicationJob job = { config, workers };
+    parallel_for(config->replications, threads, run_replication, &job);
+
+    memset(result, 0, sizeof(*result));
+    bool failed = false;
+    for (int t = 0; t < threads; t++) {
+        failed = failed || workers[t].failed;
+        stats_accumulator_merge(result, &workers[t].acc);
+        process_table_free(&workers[t].table);
+        sim_context_free(&workers[t].context);
+    }
+    free(workers);
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,70 @@
+#include "rng.h"
+#include <stdint.h>
+
+// Constantes de Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC'11)
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        uint32_t hi0 = (uint32_t)(p0 >> 32), lo0 = (uint32_t)p0;
+        uint32_t hi1 = (uint32_t)(p1 >> 32), lo1 = (uint32_t)p1;
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+void rng_init(Rng *rng, uint64_t seed, uint64_t stream) {
+    rng->key[0] = (uint32_t)seed;
+    rng->key[1] = (uint32_t)(seed >> 32);
+    rng->counter[0] = 0;
+    rng->counter[1] = 0;
+    rng->counter[2] = (uint32_t)stream;
+    rng->counter[3] = (uint32_t)(stream >> 32);
+    rng->available = 0;
+}
+
+uint32_t rng_next_u32(Rng *rng) {
+    if (rng->available == 0) {
+        philox4x32(rng->counter, rng->key, rng->buffer);
+        if (++rng->counter[0] == 0) rng->counter[1]++;
+        rng->available = 4;
+    }
+    return rng->buffer[4 - rng->available--];
+}
+
+uint64_t rng_next_u64(Rng *rng) {
+    uint64_t hi = rng_next_u32(rng);
+    return (hi << 32) | rng_next_u32(rng);
+}
+
+double rng_uniform(Rng *rng) {
+    return ((double)(rng_next_u64(rng) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+uint64_t rng_derive_seed(uint64_t seed, uint64_t index) {
+    // Usa substreams do topo do espaço de identificadores, disjuntos dos
+    // usados pelos processos (0..n-1)
+    Rng rng;
+    rng_init(&rng, seed, UINT64_MAX - index);
+    return rng_next_u64(&rng);
+}
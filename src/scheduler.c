@@ -1,26 +1,15 @@
 #include "scheduler.h"
 #include "process.h"
+#include "ready_queue.h"
+#include "counters.h"
+#include "rbtree.h"
+#include "checkpoint.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
-#include <math.h>
 #include <limits.h>
 
-// Função auxiliar para qsort - ordenar por tempo de chegada
-static int compare_arrival(const void *a, const void *b) {
-    const Process *p1 = (const Process *)a;
-    const Process *p2 = (const Process *)b;
-    return p1->arrival_time - p2->arrival_time;
-}
-
-// Função auxiliar para qsort - ordenar por período (Rate Monotonic)
-static int compare_period(const void *a, const void *b) {
-    const Process *p1 = (const Process *)a;
-    const Process *p2 = (const Process *)b;
-    return p1->period - p2->period;
-}
-
 // Funções auxiliares para LCM (Rate Monotonic e EDF)
 int gcd(int a, int b) {
     while (b != 0) {
@@ -36,337 +25,717 @@ int lcm(int a, int b) {
     return (a / gcd(a, b)) * b;
 }
 
-void run_fcfs(Process *processes, int n) {
-    qsort(processes, n, sizeof(Process), compare_arrival);
-    
-    int current_time = 0;
-    for (int i = 0; i < n; i++) {
-        if (current_time < processes[i].arrival_time) {
-            current_time = processes[i].arrival_time;
+// Contabiliza a escolha de 'selected' para executar: há troca de contexto se
+// difere do processo anterior e preempção se este ficou com trabalho por fazer
+static inline void count_dispatch(int *previous, int selected, const int *remaining_time) {
+#ifdef PROBSCHED_COUNTERS
+    COUNTER_INC(decisions);
+    if (*previous != selected) {
+        COUNTER_INC(context_switches);
+        if (*previous >= 0 && remaining_time && remaining_time[*previous] > 0) {
+            COUNTER_INC(preemptions);
         }
-        
-        processes[i].waiting_time = current_time - processes[i].arrival_time;
-        processes[i].completion_time = current_time + processes[i].burst_time;
-        current_time += processes[i].burst_time;
+        *previous = selected;
     }
+#else
+    (void)previous; (void)selected; (void)remaining_time;
+#endif
 }
 
-void run_sjf(Process *processes, int n) {
-    int *completed_flags = calloc(n, sizeof(int));
-    if (!completed_flags) return;
-    
-    int current_time = 0;
-    int completed = 0;
-    
-    while (completed < n) {
-        int shortest_index = -1;
-        int shortest_burst = INT_MAX;
-        
-        for (int i = 0; i < n; i++) {
-            if (!completed_flags[i] && processes[i].arrival_time <= current_time && 
-                processes[i].burst_time < shortest_burst) {
-                shortest_burst = processes[i].burst_time;
-                shortest_index = i;
-            }
-        }
-        
-        if (shortest_index == -1) {
-            current_time++;
-            continue;
-        }
-        
-        processes[shortest_index].waiting_time = current_time - processes[shortest_index].arrival_time;
-        processes[shortest_index].completion_time = current_time + processes[shortest_index].burst_time;
-        current_time += processes[shortest_index].burst_time;
-        completed_flags[shortest_index] = 1;
-        completed++;
-    }
-    
-    free(completed_flags);
+// Contabiliza um salto da CPU ociosa de 'from' até 'to'
+static inline void count_idle(int *previous, int from, int to) {
+#ifdef PROBSCHED_COUNTERS
+    COUNTER_INC(idle_jumps);
+    COUNTER_ADD(idle_time, to - from);
+    *previous = -1;
+#else
+    (void)previous; (void)from; (void)to;
+#endif
 }
 
-void run_priority_nonpreemptive(Process *processes, int n) {
-    int *completed_flags = calloc(n, sizeof(int));
-    if (!completed_flags) return;
-    
-    int current_time = 0;
-    int completed = 0;
-    
-    while (completed < n) {
-        int highest_priority_index = -1;
-        int highest_priority = INT_MAX;
-        
-        for (int i = 0; i < n; i++) {
-            if (!completed_flags[i] && processes[i].arrival_time <= current_time && 
-                processes[i].priority < highest_priority) {
-                highest_priority = processes[i].priority;
-                highest_priority_index = i;
-            }
-        }
-        
-        if (highest_priority_index == -1) {
-            current_time++;
-            continue;
-        }
-        
-        processes[highest_priority_index].waiting_time = current_time - processes[highest_priority_index].arrival_time;
-        processes[highest_priority_index].completion_time = current_time + processes[highest_priority_index].burst_time;
-        current_time += processes[highest_priority_index].burst_time;
-        completed_flags[highest_priority_index] = 1;
-        completed++;
+// Tempo de resposta: registado quando o processo (ou o job, em RM/EDF)
+// executa pela primeira vez, ainda com todo o burst por fazer
+static inline void record_response(ProcessTable *table, int i, int now, int release) {
+    if (table->remaining_time[i] == table->burst_time[i]) {
+        table->response_time[i] = now - release;
     }
-    
-    free(completed_flags);
 }
 
-void run_priority_preemptive(Process *processes, int n) {
-      int time = 0;
-    int completed = 0;
-    
-    // Inicializa remaining_time
-    for (int i = 0; i < n; i++) {
-        processes[i].remaining_time = processes[i].burst_time;
+static const char *const algorithm_names[ALG_COUNT] = {
+    "FCFS", "SJF", "PRIORITY_NP", "PRIORITY_P", "RR", "RM", "EDF", "CFS"
+};
+
+static const char *const algorithm_descriptions[ALG_COUNT] = {
+    "FCFS (First-Come, First-Served)",
+    "SJF (Shortest Job First)",
+    "Priority Scheduling não preemptivo",
+    "Priority Scheduling preemptivo",
+    "Round Robin",
+    "Rate Monotonic Scheduling",
+    "Earliest Deadline First Scheduling",
+    "Completely Fair Scheduler"
+};
+
+int parse_algorithm(const char *name) {
+    for (int i = 0; i < ALG_COUNT; i++) {
+        if (strcmp(name, algorithm_names[i]) == 0) return i;
     }
+    return -1;
+}
 
-    while (completed < n) {
-        int highest_priority = INT_MAX;
-        int selected = -1;
+const char *algorithm_name(Algorithm algorithm) {
+    return algorithm_names[algorithm];
+}
 
-        // Encontra o processo com maior prioridade (menor número) que já chegou e ainda tem trabalho
-        for (int i = 0; i < n; i++) {
-            if (processes[i].arrival_time <= time && processes[i].remaining_time > 0) {
-                if (processes[i].priority < highest_priority) {
-                    highest_priority = processes[i].priority;
-                    selected = i;
-                }
-            }
-        }
+const char *algorithm_description(Algorithm algorithm) {
+    return algorithm_descriptions[algorithm];
+}
 
-        if (selected == -1) {
-            time++;
-            continue;
-        }
+bool algorithm_is_real_time(Algorithm algorithm) {
+    return algorithm == ALG_RM || algorithm == ALG_EDF;
+}
 
-        // Executa o processo por 1 unidade de tempo
-        processes[selected].remaining_time--;
-        time++;
+int algorithm_total_time(Algorithm algorithm, const ProcessTable *table, int horizon) {
+    return algorithm_is_real_time(algorithm) ? horizon : simulation_end_time(table);
+}
 
-        // Verifica se o processo foi concluído
-        if (processes[selected].remaining_time == 0) {
-            completed++;
-            processes[selected].completion_time = time;
+SchedulerStats algorithm_stats(Algorithm algorithm, const ProcessTable *table, int horizon,
+                               const long long *busy_time, int cpus) {
+    int total_time = algorithm_total_time(algorithm, table, horizon);
+    SchedulerStats stats = calculate_stats(table, total_time);
+    stats_set_cpu_usage(&stats, busy_time, cpus, total_time);
+    return stats;
+}
+
+void sim_context_init(SimContext *ctx) {
+    arena_init(&ctx->arena);
+}
+
+void sim_context_free(SimContext *ctx) {
+    arena_free(&ctx->arena);
+}
+
+// Os motores tiram toda a memória temporária de 'arena', que é esvaziada
+// de uma só vez no início da execução seguinte: não há libertações nem
+// caminhos de limpeza
+static int fcfs(ProcessTable *table, Trace *trace, Arena *arena);
+static int sjf(ProcessTable *table, Trace *trace, Arena *arena);
+static int priority_nonpreemptive(ProcessTable *table, Trace *trace, Arena *arena);
+static int priority_preemptive(ProcessTable *table, Trace *trace, Arena *arena);
+static int round_robin(ProcessTable *table, int quantum, Trace *trace, Arena *arena);
+static int cfs(ProcessTable *table, int latency, int min_granularity, Trace *trace,
+               Arena *arena);
+static int rate_monotonic(ProcessTable *table, int horizon, Trace *trace,
+                          const CheckpointConfig *checkpoint, JobStats *jobs, Arena *arena);
+static int edf(ProcessTable *table, int horizon, Trace *trace,
+               const CheckpointConfig *checkpoint, JobStats *jobs, Arena *arena);
+
+int run_algorithm_in(SimContext *ctx, Algorithm algorithm, ProcessTable *table, int quantum,
+                     int horizon, Trace *trace) {
+    Arena *arena = &ctx->arena;
+    arena_reset(arena);
+    switch (algorithm) {
+        case ALG_FCFS:        return fcfs(table, trace, arena);
+        case ALG_SJF:         return sjf(table, trace, arena);
+        case ALG_PRIORITY_NP: return priority_nonpreemptive(table, trace, arena);
+        case ALG_PRIORITY_P:  return priority_preemptive(table, trace, arena);
+        case ALG_RR:          return round_robin(table, quantum, trace, arena);
+        case ALG_RM:          return rate_monotonic(table, horizon, trace, NULL, NULL, arena);
+        case ALG_EDF:         return edf(table, horizon, trace, NULL, NULL, arena);
+        case ALG_CFS: {
+            int granularity = (quantum > 0) ? quantum : CFS_DEFAULT_MIN_GRANULARITY;
+            return cfs(table, CFS_LATENCY_FACTOR * granularity, granularity, trace, arena);
         }
+        default: return -1;
     }
 }
 
-void run_rr(Process *processes, int n, int quantum) {
-    int *remaining_time = malloc(n * sizeof(int));
-    int *last_execution = malloc(n * sizeof(int));
-    if (!remaining_time || !last_execution) {
-        free(remaining_time);
-        free(last_execution);
-        return;
-    }
-    
-    for (int i = 0; i < n; i++) {
-        remaining_time[i] = processes[i].burst_time;
-        last_execution[i] = processes[i].arrival_time;
-        processes[i].waiting_time = 0;
-    }
+int run_algorithm(Algorithm algorithm, ProcessTable *table, int quantum, int horizon,
+                  Trace *trace) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    int status = run_algorithm_in(&ctx, algorithm, table, quantum, horizon, trace);
+    sim_context_free(&ctx);
+    return status;
+}
 
-    int current_time = 0;
-    while (1) {
-        bool all_done = true;
-        bool executed = false;
+int run_fcfs(ProcessTable *table, Trace *trace) {
+    return run_algorithm(ALG_FCFS, table, 0, 0, trace);
+}
 
-        for (int i = 0; i < n; i++) {
-            if (remaining_time[i] > 0) {
-                all_done = false;
-                
-                if (processes[i].arrival_time <= current_time) {
-                    executed = true;
-                    processes[i].waiting_time += current_time - last_execution[i];
-                    
-                    int exec_time = (remaining_time[i] > quantum) ? quantum : remaining_time[i];
-                    current_time += exec_time;
-                    remaining_time[i] -= exec_time;
-                    last_execution[i] = current_time;
-                    
-                    if (remaining_time[i] == 0) {
-                        processes[i].completion_time = current_time;
-                    }
-                    break;
-                }
-            }
-        }
+int run_sjf(ProcessTable *table, Trace *trace) {
+    return run_algorithm(ALG_SJF, table, 0, 0, trace);
+}
 
-        if (all_done) break;
-        if (!executed) current_time++;
-    }
+int run_priority_nonpreemptive(ProcessTable *table, Trace *trace) {
+    return run_algorithm(ALG_PRIORITY_NP, table, 0, 0, trace);
+}
 
-    free(remaining_time);
-    free(last_execution);
+int run_priority_preemptive(ProcessTable *table, Trace *trace) {
+    return run_algorithm(ALG_PRIORITY_P, table, 0, 0, trace);
 }
 
-void run_rate_monotonic(Process *processes, int n) {
-    // Filtrar processos periódicos válidos
-    int valid_count = 0;
-    for (int i = 0; i < n; i++) {
-        if (processes[i].period > 0) valid_count++;
-    }
+int run_rr(ProcessTable *table, int quantum, Trace *trace) {
+    return run_algorithm(ALG_RR, table, quantum, 0, trace);
+}
 
-    if (valid_count == 0) {
-        printf("Nenhum processo periódico válido (período > 0)\n");
-        return;
-    }
+int run_cfs_in(SimContext *ctx, ProcessTable *table, int latency, int min_granularity,
+               Trace *trace) {
+    arena_reset(&ctx->arena);
+    return cfs(table, latency, min_granularity, trace, &ctx->arena);
+}
 
-    // Ordenar por período (Rate Monotonic)
-    qsort(processes, n, sizeof(Process), compare_period);
+int run_cfs(ProcessTable *table, int latency, int min_granularity, Trace *trace) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    int status = run_cfs_in(&ctx, table, latency, min_granularity, trace);
+    sim_context_free(&ctx);
+    return status;
+}
 
-    // Calcular utilização e limite
-    float utilization = 0;
-    for (int i = 0; i < n; i++) {
-        if (processes[i].period > 0) {
-            utilization += (float)processes[i].burst_time / processes[i].period;
-        }
+int run_rate_monotonic(ProcessTable *table, int horizon, Trace *trace) {
+    return run_algorithm(ALG_RM, table, 0, horizon, trace);
+}
+
+int run_edf(ProcessTable *table, int horizon, Trace *trace) {
+    return run_algorithm(ALG_EDF, table, 0, horizon, trace);
+}
+
+int run_real_time_checkpointed(Algorithm algorithm, ProcessTable *table, int horizon,
+                               Trace *trace, const CheckpointConfig *checkpoint) {
+    return run_real_time_jobs(algorithm, table, horizon, trace, checkpoint, NULL);
+}
+
+int run_real_time_jobs_in(SimContext *ctx, Algorithm algorithm, ProcessTable *table,
+                          int horizon, Trace *trace, const CheckpointConfig *checkpoint,
+                          JobStats *jobs) {
+    Arena *arena = &ctx->arena;
+    arena_reset(arena);
+    switch (algorithm) {
+        case ALG_RM:  return rate_monotonic(table, horizon, trace, checkpoint, jobs, arena);
+        case ALG_EDF: return edf(table, horizon, trace, checkpoint, jobs, arena);
+        default:      return -1;
     }
+}
 
-    float bound = valid_count * (pow(2, 1.0/valid_count) - 1);
-    printf("Utilização: %.2f, Limite: %.2f\n", utilization, bound);
+int run_real_time_jobs(Algorithm algorithm, ProcessTable *table, int horizon, Trace *trace,
+                       const CheckpointConfig *checkpoint, JobStats *jobs) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    int status = run_real_time_jobs_in(&ctx, algorithm, table, horizon, trace, checkpoint, jobs);
+    sim_context_free(&ctx);
+    return status;
+}
 
-    // Inicializar estruturas
-    int *remaining_time = malloc(n * sizeof(int));
-    int *next_release = malloc(n * sizeof(int));
-    if (!remaining_time || !next_release) {
-        free(remaining_time);
-        free(next_release);
-        return;
+// Pesos do Linux por valor de nice (-20..19): cada nível vale ~10% de CPU
+static const int nice_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,   335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,    36,    29,    23,    18,    15
+};
+#define NICE_0_WEIGHT 1024
+
+// Tempo virtual em unidades de 1/1024 de unidade de tempo, para que pesos
+// elevados não arredondem os incrementos para zero
+#define VRUNTIME_SHIFT 10
+
+// Prioridade 1..10 (menor é mais prioritária) para nice -8..10
+static int cfs_weight(int priority) {
+    int nice = 2 * (priority - 5);
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    return nice_to_weight[nice + 20];
+}
+
+static int cfs(ProcessTable *table, int latency, int min_granularity, Trace *trace,
+               Arena *arena) {
+    int n = table->n;
+    int *remaining_time = table->remaining_time;
+    int *weight = arena_alloc_ints(arena, n);
+    RbTree runnable;
+    ArrivalCursor arrivals;
+    if (!weight || rb_tree_init_arena(&runnable, n, arena) != 0 ||
+        arrival_cursor_open_arena(&arrivals, table, arena) != 0) {
+        return -1;
     }
+    if (min_granularity < 1) min_granularity = 1;
+    if (latency < min_granularity) latency = min_granularity;
+    int nr_latency = latency / min_granularity;
 
-    int hyperperiod = 1;
     for (int i = 0; i < n; i++) {
-        remaining_time[i] = 0;
-        next_release[i] = processes[i].arrival_time;
-        if (processes[i].period > 0) {
-            hyperperiod = lcm(hyperperiod, processes[i].period);
-        }
+        remaining_time[i] = table->burst_time[i];
+        weight[i] = cfs_weight(table->priority[i]);
     }
 
-    // Simulação
+    // min_vruntime só avança; os processos que chegam começam nele, para não
+    // ganharem crédito sobre os que já estão a executar
+    long long min_vruntime = 0;
+    long long total_weight = 0;
     int current_time = 0;
-    while (current_time < hyperperiod) {
-        // Liberar processos
-        for (int i = 0; i < n; i++) {
-            if (processes[i].period > 0 && current_time >= next_release[i]) {
-                remaining_time[i] = processes[i].burst_time;
-                next_release[i] += processes[i].period;
-            }
+    int completed = 0;
+    int previous = -1;
+    while (completed < n) {
+        int i;
+        while ((i = arrival_cursor_next(&arrivals, current_time)) != -1) {
+            rb_tree_insert(&runnable, i, min_vruntime);
+            total_weight += weight[i];
         }
 
-        // Selecionar processo
-        int selected = -1;
-        for (int i = 0; i < n; i++) {
-            if (processes[i].period > 0 && remaining_time[i] > 0 && 
-                (selected == -1 || processes[i].period < processes[selected].period)) {
-                selected = i;
-            }
+        // CPU ociosa: salta para a próxima chegada
+        int selected = rb_tree_first(&runnable);
+        if (selected == -1) {
+            int next_arrival_time = arrival_cursor_peek_time(&arrivals);
+            count_idle(&previous, current_time, next_arrival_time);
+            current_time = next_arrival_time;
+            continue;
+        }
+        count_dispatch(&previous, selected, remaining_time);
+        record_response(table, selected, current_time, table->arrival_time[selected]);
+        long long vruntime = rb_tree_key(&runnable, selected);
+        rb_tree_remove(&runnable, selected);
+
+        // Fatia proporcional ao peso dentro do período de escalonamento; as
+        // chegadas durante a fatia só concorrem no fim dela (sem preempção
+        // por despertar)
+        int runnable_count = runnable.size + 1;
+        long long period = (runnable_count > nr_latency)
+            ? (long long)runnable_count * min_granularity : latency;
+        long long slice = period * weight[selected] / total_weight;
+        if (slice < min_granularity) slice = min_granularity;
+        int run = (slice < remaining_time[selected]) ? (int)slice : remaining_time[selected];
+
+        remaining_time[selected] -= run;
+        trace_add(trace, table->pid[selected], current_time, current_time + run,
+                  remaining_time[selected] == 0 ? TRACE_DONE : 0);
+        current_time += run;
+        vruntime += ((long long)run * NICE_0_WEIGHT << VRUNTIME_SHIFT) / weight[selected];
+
+        if (remaining_time[selected] == 0) {
+            table->completion_time[selected] = current_time;
+            table->waiting_time[selected] = current_time - table->arrival_time[selected] -
+                                            table->burst_time[selected];
+            total_weight -= weight[selected];
+            completed++;
+        } else {
+            rb_tree_insert(&runnable, selected, vruntime);
         }
 
-        // Execução
-        if (selected != -1) {
-            remaining_time[selected]--;
-            
-            if (remaining_time[selected] == 0) {
-                int deadline = next_release[selected] - processes[selected].period;
-                processes[selected].completion_time = current_time + 1;
-                processes[selected].waiting_time = current_time + 1 - 
-                    processes[selected].arrival_time - processes[selected].burst_time;
-                
-                if (processes[selected].completion_time > deadline) {
-                    processes[selected].deadline_misses++;
-                }
-            }
+        if (!rb_tree_empty(&runnable) &&
+            rb_tree_key(&runnable, rb_tree_first(&runnable)) > min_vruntime) {
+            min_vruntime = rb_tree_key(&runnable, rb_tree_first(&runnable));
         }
-        current_time++;
     }
+    return 0;
+}
 
-    free(remaining_time);
-    free(next_release);
+// Estado de RM/EDF que não está na tabela, gravado nos checkpoints
+typedef struct {
+    ProcessTable *table;
+    int *next_release;
+    ReadyQueue *ready;
+    ReadyQueue *releases;
+    JobStats *jobs;         // NULL sem contabilidade por job
+    long long busy_time;    // Tempo ocupado desde t=0, incluindo o de execuções anteriores
+    int current_time;
+    int previous;
+    int next_checkpoint;    // INT_MAX se não houver checkpoints a gravar
+    CheckpointHeader header;
+} PeriodicState;
+
+static void periodic_state_init(PeriodicState *s, ProcessTable *table, int *next_release,
+                                ReadyQueue *ready, ReadyQueue *releases, JobStats *jobs) {
+    s->table = table;
+    s->next_release = next_release;
+    s->ready = ready;
+    s->releases = releases;
+    s->jobs = jobs;
+    s->busy_time = 0;
+    s->current_time = 0;
+    s->previous = -1;
+    s->next_checkpoint = INT_MAX;
 }
 
-void run_edf(Process *processes, int n) {
-    // Calcular tempo de simulação
-    int simulation_time = 0;
-    for (int i = 0; i < n; i++) {
-        if (processes[i].period > 0) {
-            simulation_time = lcm(simulation_time, processes[i].period);
-        } else if (processes[i].deadline > simulation_time) {
-            simulation_time = processes[i].deadline;
+// Prepara o cabeçalho e, com config->resume, substitui o estado inicial
+// pelo gravado; devolve -1 se o checkpoint não puder ser retomado
+static int periodic_checkpoint_start(PeriodicState *s, Algorithm algorithm, int horizon,
+                                     const CheckpointConfig *config) {
+    ProcessTable *table = s->table;
+    int n = table->n;
+    memset(&s->header, 0, sizeof(s->header));
+    s->header.magic = CHECKPOINT_MAGIC;
+    s->header.version = CHECKPOINT_VERSION;
+    s->header.kind = CHECKPOINT_PERIODIC;
+    s->header.algorithm = algorithm;
+    s->header.n = n;
+    s->header.parameter = horizon;
+    s->header.fingerprint = checkpoint_fingerprint(table);
+    if (s->jobs) s->header.flags = CHECKPOINT_JOBS;
+
+    if (config->resume) {
+        CheckpointReader reader;
+        int time = checkpoint_reader_open(&reader, config->resume, &s->header);
+        if (time < 0) return -1;
+        s->current_time = time;
+        s->previous = checkpoint_read_int(&reader);
+        checkpoint_read(&reader, &s->busy_time, sizeof(s->busy_time));
+        checkpoint_read_ints(&reader, table->remaining_time, n);
+        checkpoint_read_ints(&reader, s->next_release, n);
+        checkpoint_read_ints(&reader, table->completion_time, n);
+        checkpoint_read_ints(&reader, table->waiting_time, n);
+        checkpoint_read_ints(&reader, table->response_time, n);
+        checkpoint_read_ints(&reader, table->deadline_misses, n);
+        checkpoint_read_queue(&reader, s->ready);
+        checkpoint_read_queue(&reader, s->releases);
+        if (s->jobs) job_stats_load(s->jobs, &reader);
+        if (checkpoint_reader_close(&reader) != 0) return -1;
+    }
+    if (config->path) s->next_checkpoint = checkpoint_next_time(config, s->current_time);
+    return 0;
+}
+
+// Grava o estado no início de uma iteração do ciclo de eventos; uma falha
+// é reportada mas não interrompe a simulação
+static void periodic_checkpoint_save(PeriodicState *s, const CheckpointConfig *config,
+                                     int current_time, int previous) {
+    const ProcessTable *table = s->table;
+    int n = table->n;
+    s->header.time = current_time;
+    s->next_checkpoint = checkpoint_next_time(config, current_time);
+
+    CheckpointWriter writer;
+    if (checkpoint_writer_open(&writer, config->path, &s->header) != 0) return;
+    checkpoint_write_int(&writer, previous);
+    checkpoint_write(&writer, &s->busy_time, sizeof(s->busy_time));
+    checkpoint_write_ints(&writer, table->remaining_time, n);
+    checkpoint_write_ints(&writer, s->next_release, n);
+    checkpoint_write_ints(&writer, table->completion_time, n);
+    checkpoint_write_ints(&writer, table->waiting_time, n);
+    checkpoint_write_ints(&writer, table->response_time, n);
+    checkpoint_write_ints(&writer, table->deadline_misses, n);
+    checkpoint_write_queue(&writer, s->ready);
+    checkpoint_write_queue(&writer, s->releases);
+    if (s->jobs) job_stats_save(s->jobs, &writer);
+    checkpoint_writer_close(&writer);
+}
+
+// Deadline absoluto do job corrente da tarefa periódica i, dado o instante
+// da próxima libertação (o job corrente foi libertado um período antes)
+static int job_deadline(const ProcessTable *table, int i, int next_release) {
+    return next_release - table->period[i] + process_relative_deadline(table, i);
+}
+
+// Libertação do job corrente (as tarefas aperiódicas são libertadas à chegada)
+static int job_release(const ProcessTable *table, int i, int next_release) {
+    return table->period[i] > 0 ? next_release - table->period[i] : next_release;
+}
+
+// Acumula o job acabado de concluir; o início sai do tempo de resposta
+// registado na primeira execução. Devolve -1 se faltar memória
+static int complete_job(JobStats *jobs, const ProcessTable *table, int i, int next_release,
+                        int deadline) {
+    int release = job_release(table, i, next_release);
+    return job_stats_complete(jobs, i, release, release + table->response_time[i],
+                              table->completion_time[i], deadline);
+}
+
+
+// Política de um motor: a ordem da fila de prontos, quando a escolha é
+// reconsiderada e como os processos são libertados. Cada algoritmo é uma
+// instância constante e o núcleo é expandido em cada uma, pelo que os testes
+// à política desaparecem na compilação: cada ciclo fica sem chamadas
+// indiretas nem ramos de outros algoritmos.
+//
+// Ficam fora deste núcleo, com ciclos próprios, os motores cujo estado não
+// cabe numa ProcessTable simulada de uma só vez, ou cuja escolha não é o
+// topo de uma ReadyQueue:
+// - cfs (mais acima): escolhe pelo vruntime numa árvore rubro-negra, com
+//   fatias que dependem do número de processos prontos e pesos por
+//   prioridade;
+// - run_stream (stream.c): os processos vêm de uma ProcessSource para um
+//   pool de slots reciclados, não de linhas fixas da tabela;
+// - o simulador incremental (simulator.c): para em instantes arbitrários e
+//   recebe processos novos entre chamadas, com o estado no Simulator;
+// - o escalonamento global (multicore.c): M CPUs com eventos por CPU e
+//   escolha do processo a preterir, em vez de um único escolhido.
+// Os três últimos partilham com ele as filas de prontos (ready_queue.h)
+typedef enum {
+    KEY_ARRIVAL,        // Fila FIFO pela ordem de chegada (FCFS, RR)
+    KEY_BURST,          // SJF
+    KEY_PRIORITY,       // Priority
+    KEY_PERIOD,         // RM: menor período
+    KEY_JOB_DEADLINE    // EDF: deadline absoluto do job corrente
+} ReadyKey;
+
+typedef enum {
+    RELEASE_ON_ARRIVAL, // Cada processo é libertado uma vez, à chegada
+    RELEASE_PERIODIC    // Jobs periódicos em [0, horizon), com deadlines (RM/EDF)
+} ReleaseModel;
+
+typedef struct {
+    ReadyKey key;
+    bool preemptive;        // A escolha é refeita a cada chegada ou libertação
+    bool time_sliced;       // Ao fim do quantum o processo volta ao fim da fila
+    ReleaseModel release;
+} EnginePolicy;
+
+#define ENGINE_INLINE static inline __attribute__((always_inline))
+
+// Chave de 'i' na fila de prontos quando é libertado
+ENGINE_INLINE int ready_key(const EnginePolicy policy, const ProcessTable *table, int i,
+                            int next_release) {
+    switch (policy.key) {
+        case KEY_BURST:    return table->burst_time[i];
+        case KEY_PRIORITY: return table->priority[i];
+        case KEY_PERIOD:   return table->period[i];
+        case KEY_JOB_DEADLINE:
+            // As tarefas aperiódicas têm deadline absoluto
+            return table->period[i] > 0 ? job_deadline(table, i, next_release)
+                                        : table->deadline[i];
+        default:           return 0;
+    }
+}
+
+// Deadline absoluto do job corrente de 'i' (RM/EDF); em EDF é a própria chave
+ENGINE_INLINE int current_deadline(const EnginePolicy policy, const ProcessTable *table,
+                                   const ReadyQueue *ready, int i, int next_release) {
+    if (policy.key == KEY_JOB_DEADLINE) return ready_queue_key(ready, i);
+    return job_deadline(table, i, next_release);
+}
+
+ENGINE_INLINE void admit_arrivals(const EnginePolicy policy, const ProcessTable *table,
+                                  ArrivalCursor *arrivals, ReadyQueue *ready, FifoQueue *fifo,
+                                  int now) {
+    int i;
+    while ((i = arrival_cursor_next(arrivals, now)) != -1) {
+        if (policy.key == KEY_ARRIVAL) {
+            fifo_queue_push(fifo, i);
+        } else {
+            ready_queue_push(ready, i, ready_key(policy, table, i, 0));
         }
     }
-    if (simulation_time == 0) simulation_time = 100;
-
-    // Inicializar estruturas
-    int *remaining_time = malloc(n * sizeof(int));
-    int *next_release = malloc(n * sizeof(int));
-    if (!remaining_time || !next_release) {
-        free(remaining_time);
-        free(next_release);
-        return;
+}
+
+// Liberta os jobs com libertação até 'now'; um job ainda pendente na
+// libertação seguinte perdeu o deadline e é descartado. Cada libertação é
+// contada em 'trace' (pode ser NULL)
+ENGINE_INLINE void release_jobs(const EnginePolicy policy, ProcessTable *table,
+                                int *next_release, ReadyQueue *ready, ReadyQueue *releases,
+                                int horizon, int now, JobStats *jobs, Trace *trace) {
+    int *remaining_time = table->remaining_time;
+    while (!ready_queue_empty(releases) &&
+           ready_queue_key(releases, ready_queue_peek(releases)) <= now) {
+        int i = ready_queue_peek(releases);
+        COUNTER_INC(releases);
+        if (trace) trace->releases++;
+        if (remaining_time[i] > 0) {
+            table->deadline_misses[i]++;
+            if (jobs) job_stats_drop(jobs, i);
+        }
+        remaining_time[i] = table->burst_time[i];
+
+        // Tarefas aperiódicas (só em EDF) são libertadas uma única vez
+        bool periodic = table->period[i] > 0;
+        if (periodic) next_release[i] += table->period[i];
+        ready_queue_update(ready, i, ready_key(policy, table, i, next_release[i]));
+        if (periodic && next_release[i] < horizon) {
+            ready_queue_update(releases, i, next_release[i]);
+        } else {
+            ready_queue_remove(releases, i);
+        }
     }
+}
 
-    for (int i = 0; i < n; i++) {
-        remaining_time[i] = 0;
-        next_release[i] = processes[i].arrival_time;
-        processes[i].deadline_misses = 0;
+// Núcleo comum a FCFS, SJF, Priority, RR, RM e EDF: admite as chegadas (ou
+// libertações) até ao instante atual, escolhe pela política e executa até à
+// conclusão, ao fim do quantum ou, nos preemptivos, até ao próximo evento;
+// com a CPU ociosa salta diretamente para o próximo evento. Em
+// RELEASE_PERIODIC a simulação cobre [0, horizon), com checkpoints e
+// contabilidade por job opcionais. Devolve -1 se faltar memória ou a
+// retoma falhar
+ENGINE_INLINE int run_engine(const EnginePolicy policy, ProcessTable *table, int quantum,
+                             int horizon, Trace *trace, const CheckpointConfig *checkpoint,
+                             JobStats *jobs, Arena *arena) {
+    bool periodic = policy.release == RELEASE_PERIODIC;
+    bool by_key = policy.key != KEY_ARRIVAL;
+    // Sem chave nem quantum (FCFS) a fila coincide com a ordem de chegada e
+    // o escolhido sai diretamente do cursor
+    bool arrival_order = !by_key && !policy.time_sliced;
+    int n = table->n;
+    int *remaining_time = table->remaining_time;
+
+    // 'releases' ordena as tarefas periódicas pela próxima libertação de job
+    ReadyQueue ready = {0}, releases = {0};
+    FifoQueue fifo = {0};
+    ArrivalCursor arrivals = {0};
+    int *next_release = NULL;
+    if (by_key ? ready_queue_init_arena(&ready, n, arena) != 0
+               : !arrival_order && fifo_queue_init_arena(&fifo, n, arena) != 0) {
+        return -1;
+    }
+    if (periodic) {
+        next_release = arena_alloc_ints(arena, n);
+        if (!next_release || ready_queue_init_arena(&releases, n, arena) != 0) return -1;
+    } else if (arrival_cursor_open_arena(&arrivals, table, arena) != 0) {
+        return -1;
     }
 
-    // Simulação
-    int current_time = 0;
-    while (current_time <= simulation_time) {
-        // Liberar processos
+    PeriodicState state;
+    periodic_state_init(&state, table, next_release, &ready, &releases, jobs);
+    if (periodic) {
         for (int i = 0; i < n; i++) {
-            if (current_time == next_release[i]) {
-                remaining_time[i] = processes[i].burst_time;
-                if (processes[i].period > 0) {
-                    next_release[i] += processes[i].period;
-                }
+            remaining_time[i] = 0;
+            next_release[i] = table->arrival_time[i];
+            table->deadline_misses[i] = 0;
+            // RM só liberta tarefas periódicas: sem período não há prioridade
+            bool released = policy.key != KEY_PERIOD || table->period[i] > 0;
+            if (released && next_release[i] < horizon) {
+                ready_queue_push(&releases, i, next_release[i]);
             }
         }
+        if (jobs) job_stats_reset(jobs);
 
-        // Selecionar EDF
-        int selected = -1;
-        int earliest_deadline = INT_MAX;
-
+        // Retoma de um checkpoint: substitui o estado inicial acabado de montar
+        Algorithm algorithm = policy.key == KEY_PERIOD ? ALG_RM : ALG_EDF;
+        if (checkpoint && periodic_checkpoint_start(&state, algorithm, horizon, checkpoint) != 0) {
+            return -1;
+        }
+        // O tempo ocupado do traço cobre todo o [0, horizon), para a utilização
+        if (trace) trace->busy_time += state.busy_time;
+    } else {
         for (int i = 0; i < n; i++) {
-            if (remaining_time[i] > 0) {
-                int current_deadline = (processes[i].period > 0) ? 
-                    (next_release[i] - processes[i].period) : processes[i].deadline;
-                
-                if (current_deadline < earliest_deadline) {
-                    earliest_deadline = current_deadline;
-                    selected = i;
-                }
+            remaining_time[i] = table->burst_time[i];
+        }
+    }
+
+    int time = state.current_time;
+    int previous = state.previous;
+    int completed = 0;
+    while (periodic ? time < horizon : completed < n) {
+        int next_event;
+        if (periodic) {
+            if (time >= state.next_checkpoint) {
+                periodic_checkpoint_save(&state, checkpoint, time, previous);
             }
+            release_jobs(policy, table, next_release, &ready, &releases, horizon, time, jobs,
+                         trace);
+            next_event = ready_queue_empty(&releases)
+                ? horizon : ready_queue_key(&releases, ready_queue_peek(&releases));
+        } else {
+            if (!arrival_order) admit_arrivals(policy, table, &arrivals, &ready, &fifo, time);
+            next_event = arrival_cursor_peek_time(&arrivals);
         }
 
-        // Execução
-        if (selected != -1) {
-            remaining_time[selected]--;
-            
-            if (remaining_time[selected] == 0) {
-                processes[selected].completion_time = current_time + 1;
-                processes[selected].waiting_time = current_time + 1 - 
-                    processes[selected].arrival_time - processes[selected].burst_time;
-                
-                if (processes[selected].completion_time > earliest_deadline) {
-                    processes[selected].deadline_misses++;
+        // Os preemptivos deixam o escolhido no heap até concluir
+        int selected;
+        if (arrival_order) {
+            selected = arrival_cursor_next(&arrivals, time);
+        } else if (!by_key) {
+            selected = fifo_queue_pop(&fifo);
+        } else if (policy.preemptive) {
+            selected = ready_queue_peek(&ready);
+        } else {
+            selected = ready_queue_pop(&ready);
+        }
+
+        // CPU ociosa: salta para a próxima chegada ou libertação
+        if (selected == -1) {
+            count_idle(&previous, time, next_event);
+            time = next_event;
+            continue;
+        }
+        count_dispatch(&previous, selected, remaining_time);
+        int release = periodic ? job_release(table, selected, next_release[selected])
+                               : table->arrival_time[selected];
+        record_response(table, selected, time, release);
+
+        int run = remaining_time[selected];
+        if (policy.preemptive && next_event - time < run) run = next_event - time;
+        if (policy.time_sliced && quantum < run) run = quantum;
+        remaining_time[selected] -= run;
+        time += run;
+        if (periodic) state.busy_time += run;
+
+        unsigned flags = 0;
+        if (remaining_time[selected] == 0) {
+            flags = TRACE_DONE;
+            table->completion_time[selected] = time;
+            table->waiting_time[selected] = time - table->arrival_time[selected] -
+                                            table->burst_time[selected];
+            completed++;
+            if (periodic) {
+                int deadline = current_deadline(policy, table, &ready, selected,
+                                                next_release[selected]);
+                if (time > deadline) {
+                    table->deadline_misses[selected]++;
+                    flags |= TRACE_MISS;
+                }
+                if (jobs && complete_job(jobs, table, selected, next_release[selected],
+                                         deadline) != 0) {
+                    return -1;
                 }
             }
+            if (by_key && policy.preemptive) ready_queue_remove(&ready, selected);
+        } else if (policy.time_sliced) {
+            // Quem chegou durante o quantum entra na fila antes do preemptado
+            admit_arrivals(policy, table, &arrivals, &ready, &fifo, time);
+            fifo_queue_push(&fifo, selected);
         }
-        current_time++;
+        trace_add(trace, table->pid[selected], time - run, time, flags);
     }
 
-    free(remaining_time);
-    free(next_release);
+    if (periodic) {
+        // Jobs por terminar cujo deadline já passou dentro do horizonte
+        for (int i = 0; i < n; i++) {
+            if (remaining_time[i] > 0 &&
+                current_deadline(policy, table, &ready, i, next_release[i]) <= horizon) {
+                table->deadline_misses[i]++;
+                if (jobs) job_stats_drop(jobs, i);
+            }
+        }
+    }
+    return 0;
+}
+
+static int fcfs(ProcessTable *table, Trace *trace, Arena *arena) {
+    EnginePolicy policy = { .key = KEY_ARRIVAL };
+    return run_engine(policy, table, 0, 0, trace, NULL, NULL, arena);
+}
+
+static int sjf(ProcessTable *table, Trace *trace, Arena *arena) {
+    EnginePolicy policy = { .key = KEY_BURST };
+    return run_engine(policy, table, 0, 0, trace, NULL, NULL, arena);
+}
+
+static int priority_nonpreemptive(ProcessTable *table, Trace *trace, Arena *arena) {
+    EnginePolicy policy = { .key = KEY_PRIORITY };
+    return run_engine(policy, table, 0, 0, trace, NULL, NULL, arena);
+}
+
+static int priority_preemptive(ProcessTable *table, Trace *trace, Arena *arena) {
+    EnginePolicy policy = { .key = KEY_PRIORITY, .preemptive = true };
+    return run_engine(policy, table, 0, 0, trace, NULL, NULL, arena);
+}
+
+static int round_robin(ProcessTable *table, int quantum, Trace *trace, Arena *arena) {
+    // Sem quantum positivo o processo em execução nunca avançaria
+    if (quantum <= 0) return -1;
+    EnginePolicy policy = { .key = KEY_ARRIVAL, .time_sliced = true };
+    return run_engine(policy, table, quantum, 0, trace, NULL, NULL, arena);
+}
+
+static int rate_monotonic(ProcessTable *table, int horizon, Trace *trace,
+                          const CheckpointConfig *checkpoint, JobStats *jobs, Arena *arena) {
+    EnginePolicy policy = {
+        .key = KEY_PERIOD, .preemptive = true, .release = RELEASE_PERIODIC
+    };
+    return run_engine(policy, table, 0, horizon, trace, checkpoint, jobs, arena);
+}
+
+static int edf(ProcessTable *table, int horizon, Trace *trace,
+               const CheckpointConfig *checkpoint, JobStats *jobs, Arena *arena) {
+    EnginePolicy policy = {
+        .key = KEY_JOB_DEADLINE, .preemptive = true, .release = RELEASE_PERIODIC
+    };
+    return run_engine(policy, table, 0, horizon, trace, checkpoint, jobs, arena);
 }
\ No newline at end of file
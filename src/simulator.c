@@ -0,0 +1,353 @@
+#include "simulator.h"
+#include "ready_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define SIMULATOR_INITIAL_CAPACITY 64
+
+struct Simulator {
+    Algorithm algorithm;
+    int quantum;
+    bool real_time;
+    bool preemptive;        // A escolha é refeita a cada chegada/libertação
+    bool uses_fifo;         // FCFS e RR
+
+    // Só as primeiras 'count' linhas são válidas; table.n é a capacidade
+    ProcessTable table;
+    int *next_release;      // Próxima chegada (ou libertação de job em RM/EDF)
+    int *job_deadline;      // RM/EDF: deadline absoluto do job corrente
+    int count;
+    int completed;
+
+    ReadyQueue pending;     // Chegadas e libertações futuras, por instante
+    ReadyQueue ready;
+    FifoQueue fifo;
+    int running;            // Não preemptivos e RR: processo com a CPU (-1 se nenhum)
+    int slice_used;         // RR: parte já usada do quantum corrente
+
+    int time;
+    long long busy_time;
+    Trace *trace;
+
+    // Toda a memória acima vem da arena do contexto, próprio (simulator_create)
+    // ou do chamador (simulator_create_in)
+    SimContext *ctx;
+    SimContext owned;
+    bool owns_context;
+};
+
+Simulator *simulator_create(Algorithm algorithm, int quantum) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    Simulator *sim = simulator_create_in(&ctx, algorithm, quantum);
+    if (!sim) {
+        sim_context_free(&ctx);
+        return NULL;
+    }
+    // O contexto passa a viver dentro do simulador
+    sim->owned = ctx;
+    sim->ctx = &sim->owned;
+    sim->owns_context = true;
+    return sim;
+}
+
+Simulator *simulator_create_in(SimContext *ctx, Algorithm algorithm, int quantum) {
+    if (algorithm < 0 || algorithm >= ALG_COUNT || algorithm == ALG_CFS) return NULL;
+    if (algorithm == ALG_RR && quantum <= 0) return NULL;
+
+    Simulator *sim = calloc(1, sizeof(Simulator));
+    if (!sim) return NULL;
+    sim->ctx = ctx;
+    sim->algorithm = algorithm;
+    sim->quantum = quantum;
+    sim->real_time = algorithm_is_real_time(algorithm);
+    sim->preemptive = sim->real_time || algorithm == ALG_PRIORITY_P;
+    sim->uses_fifo = algorithm == ALG_FCFS || algorithm == ALG_RR;
+    sim->running = -1;
+
+    Arena *arena = &ctx->arena;
+    int capacity = SIMULATOR_INITIAL_CAPACITY;
+    arena_reset(arena);
+    sim->next_release = arena_alloc_ints(arena, capacity);
+    sim->job_deadline = arena_alloc_ints(arena, capacity);
+    if (process_table_init_arena(&sim->table, capacity, arena) != 0 || !sim->next_release ||
+        !sim->job_deadline || ready_queue_init_arena(&sim->pending, capacity, arena) != 0 ||
+        ready_queue_init_arena(&sim->ready, capacity, arena) != 0 ||
+        fifo_queue_init_arena(&sim->fifo, capacity, arena) != 0) {
+        free(sim);
+        return NULL;
+    }
+    return sim;
+}
+
+void simulator_destroy(Simulator *sim) {
+    if (!sim) return;
+    if (sim->owns_context) sim_context_free(sim->ctx);
+    free(sim);
+}
+
+void simulator_reset(Simulator *sim) {
+    ready_queue_clear(&sim->pending);
+    ready_queue_clear(&sim->ready);
+    sim->fifo.head = sim->fifo.size = 0;
+    sim->count = 0;
+    sim->completed = 0;
+    sim->running = -1;
+    sim->slice_used = 0;
+    sim->time = 0;
+    sim->busy_time = 0;
+}
+
+void simulator_set_trace(Simulator *sim, Trace *trace) {
+    sim->trace = trace;
+}
+
+// Duplica a capacidade: a tabela é copiada para memória nova da arena (a
+// antiga só é recuperada com o contexto, o que fica abaixo do dobro do pico).
+// Cada processo está no máximo uma vez na FIFO, que acompanha a capacidade
+static int grow(Simulator *sim) {
+    Arena *arena = &sim->ctx->arena;
+    int capacity = 2 * sim->table.n;
+    ProcessTable table;
+    if (process_table_init_arena(&table, capacity, arena) != 0) return -1;
+
+    ProcessTable *old = &sim->table;
+    int *const from[] = {
+        old->pid, old->arrival_time, old->burst_time, old->priority, old->deadline,
+        old->period, old->remaining_time, old->completion_time, old->waiting_time,
+        old->response_time, old->deadline_misses
+    };
+    int *const to[] = {
+        table.pid, table.arrival_time, table.burst_time, table.priority, table.deadline,
+        table.period, table.remaining_time, table.completion_time, table.waiting_time,
+        table.response_time, table.deadline_misses
+    };
+    for (size_t c = 0; c < sizeof(from) / sizeof(from[0]); c++) {
+        memcpy(to[c], from[c], sim->count * sizeof(int));
+    }
+
+    int *next_release = arena_alloc_ints(arena, capacity);
+    int *job_deadline = arena_alloc_ints(arena, capacity);
+    if (!next_release || !job_deadline ||
+        ready_queue_reserve_arena(&sim->pending, capacity, arena) != 0 ||
+        ready_queue_reserve_arena(&sim->ready, capacity, arena) != 0 ||
+        fifo_queue_reserve_arena(&sim->fifo, capacity, arena) != 0) {
+        return -1;
+    }
+    memcpy(next_release, sim->next_release, sim->count * sizeof(int));
+    memcpy(job_deadline, sim->job_deadline, sim->count * sizeof(int));
+    sim->next_release = next_release;
+    sim->job_deadline = job_deadline;
+    sim->table = table;
+    return 0;
+}
+
+int simulator_add_process(Simulator *sim, const Process *process) {
+    if (process->arrival_time < sim->time || process->burst_time < 0 || process->period < 0) {
+        return -1;
+    }
+    if (sim->count == sim->table.n && grow(sim) != 0) return -1;
+
+    int i = sim->count++;
+    ProcessTable *table = &sim->table;
+    process_table_set(table, i, process);
+    table->remaining_time[i] = sim->real_time ? 0 : process->burst_time;
+    table->completion_time[i] = 0;
+    table->waiting_time[i] = 0;
+    table->response_time[i] = 0;
+    table->deadline_misses[i] = 0;
+    sim->next_release[i] = process->arrival_time;
+    sim->job_deadline[i] = 0;
+
+    // Em RM só as tarefas periódicas são libertadas, como em run_rate_monotonic
+    if (sim->algorithm != ALG_RM || process->period > 0) {
+        ready_queue_push(&sim->pending, i, process->arrival_time);
+    }
+    return i;
+}
+
+// Liberta um job de RM/EDF; um job anterior ainda pendente perdeu o deadline
+static void release_job(Simulator *sim, int i) {
+    ProcessTable *table = &sim->table;
+    if (table->remaining_time[i] > 0) {
+        table->deadline_misses[i]++;
+    }
+    table->remaining_time[i] = table->burst_time[i];
+    if (table->period[i] > 0) {
+        sim->job_deadline[i] = sim->next_release[i] + process_relative_deadline(table, i);
+        sim->next_release[i] += table->period[i];
+        ready_queue_update(&sim->pending, i, sim->next_release[i]);
+    } else {
+        sim->job_deadline[i] = table->deadline[i];
+        ready_queue_remove(&sim->pending, i);
+    }
+    ready_queue_update(&sim->ready, i,
+                       sim->algorithm == ALG_RM ? table->period[i] : sim->job_deadline[i]);
+}
+
+// Admite as chegadas e libertações até ao instante atual
+static int admit(Simulator *sim) {
+    ReadyQueue *pending = &sim->pending;
+    while (!ready_queue_empty(pending) &&
+           ready_queue_key(pending, ready_queue_peek(pending)) <= sim->time) {
+        int i = ready_queue_peek(pending);
+        if (sim->real_time) {
+            release_job(sim, i);
+            continue;
+        }
+        ready_queue_pop(pending);
+        switch (sim->algorithm) {
+            case ALG_FCFS:
+            case ALG_RR:
+                if (fifo_queue_push(&sim->fifo, i) != 0) return -1;
+                break;
+            case ALG_SJF:
+                ready_queue_push(&sim->ready, i, sim->table.burst_time[i]);
+                break;
+            default:
+                ready_queue_push(&sim->ready, i, sim->table.priority[i]);
+                break;
+        }
+    }
+    return 0;
+}
+
+static int select_process(Simulator *sim) {
+    if (sim->preemptive) return ready_queue_peek(&sim->ready);
+    if (sim->running < 0) {
+        sim->running = sim->uses_fifo ? fifo_queue_pop(&sim->fifo) : ready_queue_pop(&sim->ready);
+        sim->slice_used = 0;
+    }
+    return sim->running;
+}
+
+static void complete(Simulator *sim, int i) {
+    ProcessTable *table = &sim->table;
+    if (table->completion_time[i] == 0) sim->completed++;
+    table->completion_time[i] = sim->time;
+    table->waiting_time[i] = sim->time - table->arrival_time[i] - table->burst_time[i];
+    if (sim->preemptive) {
+        ready_queue_remove(&sim->ready, i);
+    } else {
+        sim->running = -1;
+    }
+    if (sim->real_time && sim->time > sim->job_deadline[i]) {
+        table->deadline_misses[i]++;
+    }
+}
+
+// Núcleo do simulador: cada iteração executa um segmento ou salta um
+// intervalo ocioso, sem passar de 'limit'. Devolve false quando não há
+// nada a simular
+static bool advance(Simulator *sim, int limit, bool single_step) {
+    ProcessTable *table = &sim->table;
+    while (sim->time < limit) {
+        if (admit(sim) != 0) return false;
+        int selected = select_process(sim);
+        int next_event = ready_queue_empty(&sim->pending)
+            ? INT_MAX : ready_queue_key(&sim->pending, ready_queue_peek(&sim->pending));
+
+        // CPU ociosa: salta para a próxima chegada
+        if (selected == -1) {
+            if (next_event == INT_MAX) return false;
+            sim->time = next_event < limit ? next_event : limit;
+            if (single_step) return true;
+            continue;
+        }
+
+        // Primeira execução do processo ou do job corrente
+        if (table->remaining_time[selected] == table->burst_time[selected]) {
+            int release = table->arrival_time[selected];
+            if (sim->real_time && table->period[selected] > 0) {
+                release = sim->next_release[selected] - table->period[selected];
+            }
+            table->response_time[selected] = sim->time - release;
+        }
+
+        // Executa até à conclusão, ao fim do quantum, à próxima chegada
+        // (preemptivos) ou ao limite pedido
+        int run = table->remaining_time[selected];
+        if (sim->preemptive && next_event != INT_MAX && next_event - sim->time < run) {
+            run = next_event - sim->time;
+        }
+        if (sim->algorithm == ALG_RR && sim->quantum - sim->slice_used < run) {
+            run = sim->quantum - sim->slice_used;
+        }
+        if (limit - sim->time < run) run = limit - sim->time;
+
+        table->remaining_time[selected] -= run;
+        bool done = table->remaining_time[selected] == 0;
+        unsigned flags = done ? TRACE_DONE : 0;
+        sim->time += run;
+        sim->busy_time += run;
+        sim->slice_used += run;
+        if (done) {
+            complete(sim, selected);
+            if (sim->real_time && sim->time > sim->job_deadline[selected]) flags |= TRACE_MISS;
+        } else if (sim->algorithm == ALG_RR && sim->slice_used == sim->quantum) {
+            // Quem chegou durante o quantum entra na fila antes do preemptado
+            if (admit(sim) != 0) return false;
+            if (fifo_queue_push(&sim->fifo, selected) != 0) return false;
+            sim->running = -1;
+        }
+        trace_add(sim->trace, table->pid[selected], sim->time - run, sim->time, flags);
+        if (single_step) return true;
+    }
+    return true;
+}
+
+int simulator_advance_to(Simulator *sim, int time) {
+    advance(sim, time, false);
+    return sim->time;
+}
+
+bool simulator_step(Simulator *sim) {
+    return advance(sim, INT_MAX, true);
+}
+
+int simulator_run(Simulator *sim) {
+    if (sim->real_time) return -1;
+    advance(sim, INT_MAX, false);
+    return sim->time;
+}
+
+int simulator_time(const Simulator *sim) {
+    return sim->time;
+}
+
+int simulator_process_count(const Simulator *sim) {
+    return sim->count;
+}
+
+int simulator_completed(const Simulator *sim) {
+    return sim->completed;
+}
+
+int simulator_get_process(const Simulator *sim, int id, Process *process) {
+    if (id < 0 || id >= sim->count) return -1;
+    process_table_get(&sim->table, id, process);
+    return 0;
+}
+
+SchedulerStats simulator_stats(const Simulator *sim) {
+    // Vista sobre as linhas válidas da tabela
+    ProcessTable view = sim->table;
+    view.n = sim->count;
+    SchedulerStats stats = calculate_stats(&view, sim->time);
+    if (sim->time <= 0) return stats;
+
+    // calculate_stats soma os bursts de todos os processos, incluindo os
+    // que ainda não executaram; aqui conta só o tempo já simulado
+    stats.cpu_utilization = (float)sim->busy_time / sim->time * 100;
+    stats.min_cpu_utilization = stats.max_cpu_utilization = stats.cpu_utilization;
+
+    if (sim->real_time) {
+        for (int i = 0; i < sim->count; i++) {
+            if (view.remaining_time[i] > 0 && sim->job_deadline[i] <= sim->time) {
+                stats.deadline_misses++;
+            }
+        }
+    }
+    return stats;
+}
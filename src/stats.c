@@ -2,10 +2,19 @@
 #include "process.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+SchedulerStats calculate_stats(const ProcessTable *table, int total_time) {
+    SchedulerStats stats = { .cpus = 1 };
+    int n = table->n;
+
+    // Os deadlines perdidos contam para todos os processos, mesmo sem
+    // conclusões: em RM/EDF uma tarefa pode perder todos os jobs sem nunca
+    // concluir nenhum
+    for (int i = 0; i < n; i++) {
+        stats.deadline_misses += table->deadline_misses[i];
+    }
 
-SchedulerStats calculate_stats(Process *processes, int n, int total_time) {
-    SchedulerStats stats = {0};
-    
     if (total_time <= 0) {
         return stats;  // Evita divisão por zero
     }
@@ -13,28 +22,28 @@ SchedulerStats calculate_stats(Process *processes, int n, int total_time) {
     // Throughput
     int completed = 0;
     for (int i = 0; i < n; i++) {
-        if (processes[i].completion_time > 0) completed++;
+        if (table->completion_time[i] > 0) completed++;
     }
     stats.throughput = (float)completed / total_time;
 
     // CPU Utilization
     int busy_time = 0;
     for (int i = 0; i < n; i++) {
-        busy_time += processes[i].burst_time;
+        busy_time += table->burst_time[i];
     }
     stats.cpu_utilization = (float)busy_time / total_time * 100;
+    stats.min_cpu_utilization = stats.max_cpu_utilization = stats.cpu_utilization;
 
     // Waiting/Turnaround Time
-    float total_waiting = 0, total_turnaround = 0;
-    int deadline_misses = 0;
+    float total_waiting = 0, total_turnaround = 0, total_response = 0;
     int valid_processes = 0;
 
     for (int i = 0; i < n; i++) {
-        if (processes[i].completion_time > 0) {
-            int turnaround = processes[i].completion_time - processes[i].arrival_time;
+        if (table->completion_time[i] > 0) {
+            int turnaround = table->completion_time[i] - table->arrival_time[i];
             total_turnaround += turnaround;
-            total_waiting += processes[i].waiting_time;
-            deadline_misses += processes[i].deadline_misses;
+            total_waiting += table->waiting_time[i];
+            total_response += table->response_time[i];
             valid_processes++;
         }
     }
@@ -42,17 +51,245 @@ SchedulerStats calculate_stats(Process *processes, int n, int total_time) {
     if (valid_processes > 0) {
         stats.avg_waiting_time = total_waiting / valid_processes;
         stats.avg_turnaround_time = total_turnaround / valid_processes;
+        stats.avg_response_time = total_response / valid_processes;
     }
-    stats.deadline_misses = deadline_misses;
 
     return stats;
 }
 
+void latency_histograms_reset(LatencyHistograms *latency) {
+    histogram_reset(&latency->waiting_time);
+    histogram_reset(&latency->turnaround_time);
+    histogram_reset(&latency->response_time);
+}
+
+void latency_histograms_add(LatencyHistograms *latency, const Process *completed) {
+    histogram_record(&latency->waiting_time, completed->waiting_time);
+    histogram_record(&latency->turnaround_time,
+                     completed->completion_time - completed->arrival_time);
+    histogram_record(&latency->response_time, completed->response_time);
+}
+
+void latency_histograms_add_table(LatencyHistograms *latency, const ProcessTable *table) {
+    for (int i = 0; i < table->n; i++) {
+        if (table->completion_time[i] > 0) {
+            histogram_record(&latency->waiting_time, table->waiting_time[i]);
+            histogram_record(&latency->turnaround_time,
+                             table->completion_time[i] - table->arrival_time[i]);
+            histogram_record(&latency->response_time, table->response_time[i]);
+        }
+    }
+}
+
+void latency_histograms_merge(LatencyHistograms *into, const LatencyHistograms *from) {
+    histogram_merge(&into->waiting_time, &from->waiting_time);
+    histogram_merge(&into->turnaround_time, &from->turnaround_time);
+    histogram_merge(&into->response_time, &from->response_time);
+}
+
+static LatencyPercentiles percentiles_of(const Histogram *h) {
+    LatencyPercentiles p = {
+        .p50 = histogram_percentile(h, 50),
+        .p90 = histogram_percentile(h, 90),
+        .p99 = histogram_percentile(h, 99),
+        .p999 = histogram_percentile(h, 99.9),
+        .max = h->max
+    };
+    return p;
+}
+
+void stats_set_percentiles(SchedulerStats *stats, const LatencyHistograms *latency) {
+    stats->has_percentiles = latency->turnaround_time.count > 0;
+    stats->waiting_percentiles = percentiles_of(&latency->waiting_time);
+    stats->turnaround_percentiles = percentiles_of(&latency->turnaround_time);
+    stats->response_percentiles = percentiles_of(&latency->response_time);
+}
+
+int calculate_percentiles(const ProcessTable *table, SchedulerStats *stats) {
+    LatencyHistograms *latency = malloc(sizeof(LatencyHistograms));
+    if (!latency) return -1;
+    latency_histograms_reset(latency);
+    latency_histograms_add_table(latency, table);
+    stats_set_percentiles(stats, latency);
+    free(latency);
+    return 0;
+}
+
+static void print_percentile_row(const char *label, const LatencyPercentiles *p) {
+    printf("    %-12s %8d %8d %8d %8d %8d\n", label, p->p50, p->p90, p->p99, p->p999, p->max);
+}
+
+static void print_percentiles(const SchedulerStats *stats) {
+    printf("    %-12s %8s %8s %8s %8s %9s\n", "", "p50", "p90", "p99", "p99.9", "máx.");
+    print_percentile_row("espera", &stats->waiting_percentiles);
+    print_percentile_row("turnaround", &stats->turnaround_percentiles);
+    print_percentile_row("resposta", &stats->response_percentiles);
+}
+
+void stats_set_cpu_usage(SchedulerStats *stats, const long long *busy_time, int cpus,
+                         int total_time) {
+    stats->cpus = cpus;
+    if (total_time <= 0 || cpus <= 0) return;
+
+    long long total_busy = 0;
+    long long min_busy = busy_time[0], max_busy = busy_time[0];
+    for (int cpu = 0; cpu < cpus; cpu++) {
+        total_busy += busy_time[cpu];
+        if (busy_time[cpu] < min_busy) min_busy = busy_time[cpu];
+        if (busy_time[cpu] > max_busy) max_busy = busy_time[cpu];
+    }
+    stats->cpu_utilization = (float)((double)total_busy / cpus / total_time * 100);
+    stats->min_cpu_utilization = (float)((double)min_busy / total_time * 100);
+    stats->max_cpu_utilization = (float)((double)max_busy / total_time * 100);
+}
+
 void print_stats(SchedulerStats stats) {
     printf("\n=== Estatísticas da Simulação ===\n\n");
     printf("- Tempo médio de espera: %.2f\n", stats.avg_waiting_time);
     printf("- Tempo médio de turnaround: %.2f\n", stats.avg_turnaround_time);
-    printf("- Utilização da CPU: %.2f%%\n", stats.cpu_utilization);
+    printf("- Tempo médio de resposta: %.2f\n", stats.avg_response_time);
+    if (stats.cpus > 1) {
+        printf("- Utilização média das %d CPUs: %.2f%% (mín. %.2f%%, máx. %.2f%%)\n",
+               stats.cpus, stats.cpu_utilization, stats.min_cpu_utilization,
+               stats.max_cpu_utilization);
+    } else {
+        printf("- Utilização da CPU: %.2f%%\n", stats.cpu_utilization);
+    }
     printf("- Throughput: %.2f processos/unidade de tempo\n", stats.throughput);
     printf("- Deadlines perdidos: %d\n", stats.deadline_misses);
-}
\ No newline at end of file
+    if (stats.has_percentiles) {
+        printf("- Percentis:\n");
+        print_percentiles(&stats);
+    }
+}
+
+int simulation_end_time(const ProcessTable *table) {
+    int total_time = 0;
+    for (int i = 0; i < table->n; i++) {
+        if (table->completion_time[i] > total_time) {
+            total_time = table->completion_time[i];
+        }
+    }
+    return total_time;
+}
+
+void online_stats_add(OnlineStats *online, const Process *retired) {
+    int turnaround = retired->completion_time - retired->arrival_time;
+    running_stat_add(&online->turnaround_time, turnaround);
+    running_stat_add(&online->waiting_time, retired->waiting_time);
+    running_stat_add(&online->response_time, retired->response_time);
+    latency_histograms_add(&online->latency, retired);
+    online->busy_time += retired->burst_time;
+    online->deadline_misses += retired->deadline_misses;
+    if (retired->completion_time > online->end_time) {
+        online->end_time = retired->completion_time;
+    }
+}
+
+// Mesmas métricas que calculate_stats, sem percorrer o array de processos
+SchedulerStats online_stats_result(const OnlineStats *online) {
+    SchedulerStats stats = { .cpus = 1 };
+    if (online->end_time <= 0) return stats;
+
+    stats.throughput = (float)online->turnaround_time.count / online->end_time;
+    stats.cpu_utilization = (float)online->busy_time / online->end_time * 100;
+    stats.min_cpu_utilization = stats.max_cpu_utilization = stats.cpu_utilization;
+    stats.avg_waiting_time = online->waiting_time.mean;
+    stats.avg_turnaround_time = online->turnaround_time.mean;
+    stats.avg_response_time = online->response_time.mean;
+    stats.deadline_misses = (int)online->deadline_misses;
+    stats_set_percentiles(&stats, &online->latency);
+    return stats;
+}
+
+void running_stat_add(RunningStat *stat, double value) {
+    stat->count++;
+    double delta = value - stat->mean;
+    stat->mean += delta / stat->count;
+    stat->m2 += delta * (value - stat->mean);
+}
+
+void running_stat_merge(RunningStat *into, const RunningStat *from) {
+    if (from->count == 0) return;
+    if (into->count == 0) {
+        *into = *from;
+        return;
+    }
+
+    // Combinação de Chan et al. para médias/variâncias parciais
+    long long count = into->count + from->count;
+    double delta = from->mean - into->mean;
+    into->mean += delta * from->count / count;
+    into->m2 += from->m2 + delta * delta * ((double)into->count * from->count / count);
+    into->count = count;
+}
+
+double running_stat_variance(const RunningStat *stat) {
+    return (stat->count > 1) ? stat->m2 / (stat->count - 1) : 0.0;
+}
+
+// Quantil 0.975 da t de Student com df graus de liberdade
+static double student_t_975(long long df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df <= 0) return 0.0;
+    if (df <= 30) return table[df - 1];
+
+    // Expansão de Cornish-Fisher em torno da normal
+    double z = 1.959964;
+    double z3 = z * z * z;
+    double z5 = z3 * z * z;
+    return z + (z3 + z) / (4.0 * df) + (5 * z5 + 16 * z3 + 3 * z) / (96.0 * df * df);
+}
+
+double running_stat_ci95(const RunningStat *stat) {
+    if (stat->count < 2) return 0.0;
+    return student_t_975(stat->count - 1) * sqrt(running_stat_variance(stat) / stat->count);
+}
+
+void stats_accumulator_add(StatsAccumulator *acc, SchedulerStats stats) {
+    running_stat_add(&acc->waiting_time, stats.avg_waiting_time);
+    running_stat_add(&acc->turnaround_time, stats.avg_turnaround_time);
+    running_stat_add(&acc->response_time, stats.avg_response_time);
+    running_stat_add(&acc->cpu_utilization, stats.cpu_utilization);
+    running_stat_add(&acc->throughput, stats.throughput);
+    running_stat_add(&acc->deadline_misses, stats.deadline_misses);
+}
+
+void stats_accumulator_merge(StatsAccumulator *into, const StatsAccumulator *from) {
+    running_stat_merge(&into->waiting_time, &from->waiting_time);
+    running_stat_merge(&into->turnaround_time, &from->turnaround_time);
+    running_stat_merge(&into->response_time, &from->response_time);
+    running_stat_merge(&into->cpu_utilization, &from->cpu_utilization);
+    running_stat_merge(&into->throughput, &from->throughput);
+    running_stat_merge(&into->deadline_misses, &from->deadline_misses);
+    latency_histograms_merge(&into->latency, &from->latency);
+}
+
+void print_stats_summary(const StatsAccumulator *acc) {
+    printf("\n=== Estatísticas de %lld Replicações (média ± IC 95%%) ===\n\n",
+           acc->waiting_time.count);
+    printf("- Tempo médio de espera: %.2f ± %.2f\n",
+           acc->waiting_time.mean, running_stat_ci95(&acc->waiting_time));
+    printf("- Tempo médio de turnaround: %.2f ± %.2f\n",
+           acc->turnaround_time.mean, running_stat_ci95(&acc->turnaround_time));
+    printf("- Tempo médio de resposta: %.2f ± %.2f\n",
+           acc->response_time.mean, running_stat_ci95(&acc->response_time));
+    printf("- Utilização da CPU: %.2f%% ± %.2f\n",
+           acc->cpu_utilization.mean, running_stat_ci95(&acc->cpu_utilization));
+    printf("- Throughput: %.4f ± %.4f processos/unidade de tempo\n",
+           acc->throughput.mean, running_stat_ci95(&acc->throughput));
+    printf("- Deadlines perdidos: %.2f ± %.2f\n",
+           acc->deadline_misses.mean, running_stat_ci95(&acc->deadline_misses));
+
+    SchedulerStats pooled = {0};
+    stats_set_percentiles(&pooled, &acc->latency);
+    if (pooled.has_percentiles) {
+        printf("- Percentis dos %llu processos concluídos em todas as replicações:\n",
+               (unsigned long long)acc->latency.turnaround_time.count);
+        print_percentiles(&pooled);
+    }
+}
@@ -0,0 +1,372 @@
+#include "stream.h"
+#include "ready_queue.h"
+#include "process.h"
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+
+static bool generated_next(ProcessSource *base, Process *out) {
+    GeneratedSource *source = (GeneratedSource *)base;
+    if (source->produced >= source->count) return false;
+
+    generate_stream_process(out, source->produced, source->last_arrival,
+                            source->mean_interarrival, source->seed);
+    source->last_arrival = out->arrival_time;
+    source->produced++;
+    return true;
+}
+
+// A fonte gerada é reconstruída a partir da semente: basta a posição atual
+static void generated_save(ProcessSource *base, CheckpointWriter *w) {
+    GeneratedSource *source = (GeneratedSource *)base;
+    checkpoint_write(w, &source->seed, sizeof(source->seed));
+    checkpoint_write(w, &source->mean_interarrival, sizeof(source->mean_interarrival));
+    checkpoint_write_int(w, source->count);
+    checkpoint_write_int(w, source->produced);
+    checkpoint_write_int(w, source->last_arrival);
+}
+
+static void generated_restore(ProcessSource *base, CheckpointReader *r) {
+    GeneratedSource *source = (GeneratedSource *)base;
+    uint64_t seed;
+    double mean_interarrival;
+    checkpoint_read(r, &seed, sizeof(seed));
+    checkpoint_read(r, &mean_interarrival, sizeof(mean_interarrival));
+    int count = checkpoint_read_int(r);
+    int produced = checkpoint_read_int(r);
+    int last_arrival = checkpoint_read_int(r);
+    if (seed != source->seed || mean_interarrival != source->mean_interarrival ||
+        count != source->count || produced < 0 || produced > count) {
+        r->failed = true;
+        return;
+    }
+    source->produced = produced;
+    source->last_arrival = last_arrival;
+}
+
+void generated_source_init(GeneratedSource *source, int count, uint64_t seed,
+                           double mean_interarrival) {
+    source->base.next = generated_next;
+    source->base.save = generated_save;
+    source->base.restore = generated_restore;
+    source->count = count;
+    source->produced = 0;
+    source->last_arrival = 0;
+    source->mean_interarrival = mean_interarrival;
+    source->seed = seed;
+}
+
+// Processos vivos (já chegaram e ainda não terminaram); os slots libertados
+// são reutilizados, pelo que a memória acompanha o pico de processos vivos.
+// Os arrays vêm da arena do contexto: ao crescer são copiados para outros
+// com o dobro da capacidade e os antigos só voltam à arena no reset, o que
+// fica abaixo do dobro do pico
+typedef struct {
+    Process *slots;
+    int *pids;          // pid de cada slot, usado no desempate da fila
+    int *free_slots;
+    int free_count;
+    int used;           // Slots alguma vez usados
+    int capacity;
+    int live;
+} ProcessPool;
+
+static int pool_init(ProcessPool *pool, int capacity, Arena *arena) {
+    memset(pool, 0, sizeof(*pool));
+    pool->slots = arena_alloc(arena, capacity * sizeof(Process));
+    pool->pids = arena_alloc_ints(arena, capacity);
+    pool->free_slots = arena_alloc_ints(arena, capacity);
+    pool->capacity = capacity;
+    return (pool->slots && pool->pids && pool->free_slots) ? 0 : -1;
+}
+
+static int pool_grow(ProcessPool *pool, Arena *arena) {
+    int capacity = 2 * pool->capacity;
+    Process *slots = arena_alloc(arena, capacity * sizeof(Process));
+    int *pids = arena_alloc_ints(arena, capacity);
+    int *free_slots = arena_alloc_ints(arena, capacity);
+    if (!slots || !pids || !free_slots) return -1;
+    memcpy(slots, pool->slots, pool->used * sizeof(Process));
+    memcpy(pids, pool->pids, pool->used * sizeof(int));
+    memcpy(free_slots, pool->free_slots, pool->free_count * sizeof(int));
+    pool->slots = slots;
+    pool->pids = pids;
+    pool->free_slots = free_slots;
+    pool->capacity = capacity;
+    return 0;
+}
+
+static void pool_release(ProcessPool *pool, int slot) {
+    pool->free_slots[pool->free_count++] = slot;
+    pool->live--;
+}
+
+// As filas têm sempre a capacidade do pool: cada slot vivo está no máximo
+// numa delas, pelo que nunca crescem sozinhas
+typedef struct {
+    Algorithm algorithm;
+    Arena *arena;
+    ProcessPool pool;
+    ReadyQueue ready;
+    FifoQueue fifo;
+} StreamState;
+
+static int stream_grow(StreamState *state) {
+    if (pool_grow(&state->pool, state->arena) != 0 ||
+        ready_queue_reserve_arena(&state->ready, state->pool.capacity, state->arena) != 0 ||
+        fifo_queue_reserve_arena(&state->fifo, state->pool.capacity, state->arena) != 0) {
+        return -1;
+    }
+    state->ready.tiebreak = state->pool.pids;
+    return 0;
+}
+
+// Coloca um processo acabado de chegar num slot e na fila de prontos
+static int admit(StreamState *state, const Process *process) {
+    ProcessPool *pool = &state->pool;
+    int slot;
+    if (pool->free_count > 0) {
+        slot = pool->free_slots[--pool->free_count];
+    } else {
+        if (pool->used == pool->capacity && stream_grow(state) != 0) return -1;
+        slot = pool->used++;
+    }
+
+    pool->slots[slot] = *process;
+    pool->pids[slot] = process->pid;
+    pool->live++;
+
+    switch (state->algorithm) {
+        case ALG_FCFS:
+        case ALG_RR:
+            return fifo_queue_push(&state->fifo, slot);
+        case ALG_SJF:
+            ready_queue_push(&state->ready, slot, process->burst_time);
+            return 0;
+        default:
+            ready_queue_push(&state->ready, slot, process->priority);
+            return 0;
+    }
+}
+
+// Posição da simulação fora das filas e do pool: o instante atual e o
+// próximo processo já lido da fonte mas ainda não admitido
+typedef struct {
+    int current_time;
+    bool has_next;
+    Process next;
+} StreamCursor;
+
+static void stream_header(CheckpointHeader *header, Algorithm algorithm, int quantum) {
+    memset(header, 0, sizeof(*header));
+    header->magic = CHECKPOINT_MAGIC;
+    header->version = CHECKPOINT_VERSION;
+    header->kind = CHECKPOINT_STREAM;
+    header->algorithm = algorithm;
+    header->parameter = quantum;
+}
+
+static void stream_save(const StreamState *state, ProcessSource *source,
+                        const StreamCursor *cursor, const StreamResult *result,
+                        int quantum, const char *path) {
+    const ProcessPool *pool = &state->pool;
+    CheckpointHeader header;
+    stream_header(&header, state->algorithm, quantum);
+    header.time = cursor->current_time;
+
+    CheckpointWriter w;
+    if (checkpoint_writer_open(&w, path, &header) != 0) return;
+    checkpoint_write_int(&w, cursor->has_next);
+    checkpoint_write(&w, &cursor->next, sizeof(cursor->next));
+    source->save(source, &w);
+    checkpoint_write(&w, result, sizeof(*result));
+    checkpoint_write_int(&w, pool->capacity);
+    checkpoint_write_int(&w, pool->live);
+    checkpoint_write_ints(&w, pool->free_slots, pool->free_count);
+    checkpoint_write_int(&w, pool->used);
+    checkpoint_write(&w, pool->slots, pool->used * sizeof(Process));
+    checkpoint_write_ints(&w, pool->pids, pool->used);
+    checkpoint_write_queue(&w, &state->ready);
+    checkpoint_write_fifo(&w, &state->fifo);
+    checkpoint_writer_close(&w);
+}
+
+static int stream_restore(StreamState *state, ProcessSource *source, StreamCursor *cursor,
+                          StreamResult *result, int quantum, const char *path) {
+    ProcessPool *pool = &state->pool;
+    CheckpointHeader expected;
+    stream_header(&expected, state->algorithm, quantum);
+
+    CheckpointReader r;
+    int time = checkpoint_reader_open(&r, path, &expected);
+    if (time < 0) return -1;
+    cursor->current_time = time;
+    cursor->has_next = checkpoint_read_int(&r) != 0;
+    checkpoint_read(&r, &cursor->next, sizeof(cursor->next));
+    source->restore(source, &r);
+    checkpoint_read(&r, result, sizeof(*result));
+
+    // O pool e as filas crescem até à capacidade gravada
+    int capacity = checkpoint_read_int(&r);
+    while (!r.failed && pool->capacity < capacity) {
+        if (stream_grow(state) != 0) r.failed = true;
+    }
+
+    pool->live = checkpoint_read_int(&r);
+    pool->free_count = checkpoint_read_int(&r);
+    if (pool->free_count < 0 || pool->free_count > pool->capacity) r.failed = true;
+    checkpoint_read(&r, pool->free_slots, pool->free_count * sizeof(int));
+    pool->used = checkpoint_read_int(&r);
+    if (pool->used < pool->free_count || pool->used > pool->capacity ||
+        pool->live != pool->used - pool->free_count) {
+        r.failed = true;
+    }
+    checkpoint_read(&r, pool->slots, pool->used * sizeof(Process));
+    checkpoint_read_ints(&r, pool->pids, pool->used);
+    checkpoint_read_queue(&r, &state->ready);
+    checkpoint_read_fifo(&r, &state->fifo);
+
+    // Os índices guardados têm de apontar para slots já usados
+    for (int i = 0; i < pool->free_count && !r.failed; i++) {
+        if (pool->free_slots[i] < 0 || pool->free_slots[i] >= pool->used) r.failed = true;
+    }
+    for (int i = 0; i < state->fifo.size && !r.failed; i++) {
+        int slot = state->fifo.items[i];
+        if (slot < 0 || slot >= pool->used) r.failed = true;
+    }
+    for (int i = 0; i < state->ready.size && !r.failed; i++) {
+        if (state->ready.heap[i] >= pool->used) r.failed = true;
+    }
+    return checkpoint_reader_close(&r);
+}
+
+int run_stream_in(SimContext *ctx, Algorithm algorithm, ProcessSource *source, int quantum,
+                  const CheckpointConfig *checkpoint, StreamResult *result) {
+    memset(result, 0, sizeof(*result));
+    if (algorithm_is_real_time(algorithm) || algorithm == ALG_CFS) return -1;
+    if (algorithm == ALG_RR && quantum <= 0) return -1;
+    if (checkpoint && (!source->save || !source->restore)) return -1;
+
+    arena_reset(&ctx->arena);
+    StreamState state = { .algorithm = algorithm, .arena = &ctx->arena };
+    int initial = 1024;
+    if (pool_init(&state.pool, initial, state.arena) != 0 ||
+        ready_queue_init_arena(&state.ready, initial, state.arena) != 0 ||
+        fifo_queue_init_arena(&state.fifo, initial, state.arena) != 0) {
+        return -1;
+    }
+    state.ready.tiebreak = state.pool.pids;
+
+    bool uses_fifo = (algorithm == ALG_FCFS || algorithm == ALG_RR);
+    StreamCursor cursor = {0};
+    int status = 0;
+    if (checkpoint && checkpoint->resume) {
+        status = stream_restore(&state, source, &cursor, result, quantum, checkpoint->resume);
+    } else {
+        cursor.has_next = source->next(source, &cursor.next);
+    }
+    Process next = cursor.next;
+    bool has_next = cursor.has_next;
+    int current_time = cursor.current_time;
+    int next_checkpoint = INT_MAX;
+    if (checkpoint && checkpoint->path) {
+        next_checkpoint = checkpoint_next_time(checkpoint, current_time);
+    }
+
+    while (status == 0) {
+        if (current_time >= next_checkpoint) {
+            cursor = (StreamCursor){ current_time, has_next, next };
+            stream_save(&state, source, &cursor, result, quantum, checkpoint->path);
+            next_checkpoint = checkpoint_next_time(checkpoint, current_time);
+        }
+
+        // Admitir chegadas até ao instante atual
+        while (has_next && next.arrival_time <= current_time) {
+            if (admit(&state, &next) != 0) {
+                status = -1;
+                break;
+            }
+            has_next = source->next(source, &next);
+        }
+        if (status != 0) break;
+        if (state.pool.live > result->peak_live) result->peak_live = state.pool.live;
+
+        int slot;
+        if (uses_fifo) {
+            slot = fifo_queue_pop(&state.fifo);
+        } else if (algorithm == ALG_PRIORITY_P) {
+            slot = ready_queue_peek(&state.ready);
+        } else {
+            slot = ready_queue_pop(&state.ready);
+        }
+
+        // CPU ociosa: salta para a próxima chegada
+        if (slot == -1) {
+            if (!has_next) break;
+            current_time = next.arrival_time;
+            continue;
+        }
+
+        Process *process = &state.pool.slots[slot];
+        if (process->remaining_time == process->burst_time) {
+            process->response_time = current_time - process->arrival_time;
+        }
+        int run = process->remaining_time;
+        if (algorithm == ALG_RR && run > quantum) {
+            run = quantum;
+        }
+        if (algorithm == ALG_PRIORITY_P && has_next && next.arrival_time - current_time < run) {
+            run = next.arrival_time - current_time;
+        }
+        process->remaining_time -= run;
+        current_time += run;
+
+        // RR: quem chegou durante o quantum entra na fila antes do preemptado
+        if (algorithm == ALG_RR) {
+            while (has_next && next.arrival_time <= current_time) {
+                if (admit(&state, &next) != 0) {
+                    status = -1;
+                    break;
+                }
+                has_next = source->next(source, &next);
+            }
+            if (status != 0) break;
+            process = &state.pool.slots[slot];
+        }
+
+        if (process->remaining_time > 0) {
+            if (algorithm == ALG_RR) fifo_queue_push(&state.fifo, slot);
+            continue;
+        }
+
+        // Retirar o processo: contabilizar e libertar o slot
+        if (algorithm == ALG_PRIORITY_P) ready_queue_pop(&state.ready);
+        process->completion_time = current_time;
+        process->waiting_time = current_time - process->arrival_time - process->burst_time;
+        online_stats_add(&result->online, process);
+        pool_release(&state.pool, slot);
+    }
+    return status;
+}
+
+int run_stream(Algorithm algorithm, ProcessSource *source, int quantum,
+               const CheckpointConfig *checkpoint, StreamResult *result) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    int status = run_stream_in(&ctx, algorithm, source, quantum, checkpoint, result);
+    sim_context_free(&ctx);
+    return status;
+}
+
+void print_stream_result(const StreamResult *result) {
+    print_stats(online_stats_result(&result->online));
+    printf("- Desvio padrão da espera: %.2f\n",
+           sqrt(running_stat_variance(&result->online.waiting_time)));
+    printf("- Desvio padrão do turnaround: %.2f\n",
+           sqrt(running_stat_variance(&result->online.turnaround_time)));
+    printf("- Processos concluídos: %lld\n", result->online.turnaround_time.count);
+    printf("- Pico de processos em memória: %d\n", result->peak_live);
+}
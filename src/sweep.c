@@ -0,0 +1,315 @@
+#include "sweep.h"
+#include "process.h"
+#include "analysis.h"
+#include "parallel.h"
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+// Limites da grelha, para que um passo mal escrito não esgote a memória
+#define MAX_SWEEP_VALUES 100000
+#define MAX_SWEEP_POINTS 1000000
+
+void sweep_range_single(SweepRange *range, double value) {
+    range->start = range->end = value;
+    range->step = 1;
+    range->geometric = false;
+    range->set = false;
+}
+
+// "início[:fim[:passo]]", passo aditivo ou "xK" multiplicativo
+static int parse_range(const char *name, const char *text, SweepRange *range) {
+    char *end;
+    range->start = strtod(text, &end);
+    range->end = range->start;
+    range->step = 1;
+    range->geometric = false;
+    range->set = true;
+    if (end == text) goto invalid;
+    if (*end == ':') {
+        text = end + 1;
+        range->end = strtod(text, &end);
+        if (end == text) goto invalid;
+        if (*end == ':') {
+            text = end + 1;
+            if (*text == 'x') {
+                range->geometric = true;
+                text++;
+            }
+            range->step = strtod(text, &end);
+            if (end == text) goto invalid;
+        }
+    }
+    if (*end != '\0') goto invalid;
+    if (range->end < range->start ||
+        (range->geometric ? range->step <= 1 : range->step <= 0)) {
+        fprintf(stderr, "Erro: intervalo vazio ou passo inválido em %s\n", name);
+        return -1;
+    }
+    return 0;
+
+invalid:
+    fprintf(stderr, "Erro: intervalo inválido para %s: %s\n", name, text);
+    return -1;
+}
+
+int parse_sweep(const char *spec, SweepConfig *config) {
+    char *copy = strdup(spec);
+    if (!copy) return -1;
+
+    int status = 0;
+    char *saveptr;
+    for (char *item = strtok_r(copy, ",", &saveptr); item && status == 0;
+         item = strtok_r(NULL, ",", &saveptr)) {
+        char *value = strchr(item, '=');
+        if (!value) {
+            fprintf(stderr, "Erro: parâmetro sem valor em --sweep: %s\n", item);
+            status = -1;
+            break;
+        }
+        *value++ = '\0';
+
+        SweepRange *range;
+        if (strcmp(item, "quantum") == 0) {
+            range = &config->quantum;
+        } else if (strcmp(item, "n") == 0) {
+            range = &config->processes;
+        } else if (strcmp(item, "lambda") == 0) {
+            range = &config->lambda;
+        } else {
+            fprintf(stderr, "Erro: parâmetro desconhecido em --sweep: %s\n", item);
+            status = -1;
+            break;
+        }
+        status = parse_range(item, value, range);
+        bool valid = (range == &config->lambda) ? range->start > 0 : range->start >= 1;
+        if (status == 0 && !valid) {
+            fprintf(stderr, "Erro: %s tem de ser positivo\n", item);
+            status = -1;
+        }
+    }
+    free(copy);
+    return status;
+}
+
+// Valores do intervalo; devolve quantos (-1 se faltar memória ou exceder o limite)
+static int expand_range(const SweepRange *range, double **out) {
+    int count = 0;
+    double *values = malloc(MAX_SWEEP_VALUES * sizeof(double));
+    if (!values) return -1;
+
+    // Tolerância para passos decimais que não somam exatamente ao fim
+    double slack = range->geometric ? range->end * 1e-9 : range->step * 1e-9;
+    for (double v = range->start; v <= range->end + slack; ) {
+        if (count == MAX_SWEEP_VALUES) {
+            fprintf(stderr, "Erro: mais de %d valores num parâmetro de --sweep\n",
+                    MAX_SWEEP_VALUES);
+            free(values);
+            return -1;
+        }
+        values[count++] = v;
+        v = range->geometric ? v * range->step : range->start + count * range->step;
+    }
+    *out = values;
+    return count;
+}
+
+// Carga partilhada pelos pontos com os mesmos (n, lambda)
+typedef struct {
+    int n;
+    double lambda;          // 0 = chegadas da geração normal
+    int horizon;
+    ProcessTable table;
+    bool ok;
+} SweepWorkload;
+
+typedef struct {
+    int workload;
+    int quantum;
+    SchedulerStats stats;
+    bool ok;
+    bool done;
+} SweepPoint;
+
+typedef struct {
+    const SweepConfig *config;
+    SweepWorkload *workloads;
+    SweepPoint *points;
+    SimContext *contexts;   // Um por worker, reutilizado entre pontos
+    LatencyHistograms *latency;     // Um por worker
+    int point_count;
+    int next_row;           // Primeiro ponto ainda por escrever
+    int failures;
+    FILE *out;
+    pthread_mutex_t lock;
+} SweepJob;
+
+static void generate_workload(int index, int worker, void *arg) {
+    SweepJob *job = (SweepJob *)arg;
+    SweepWorkload *w = &job->workloads[index];
+    bool real_time = algorithm_is_real_time(job->config->algorithm);
+    (void)worker;
+
+    if (process_table_init(&w->table, w->n) != 0) return;
+
+    // Geração sequencial: o paralelismo já está nas cargas; com lambda as
+    // chegadas seguem um processo de Poisson com essa taxa
+    Process process;
+    int previous_arrival = 0;
+    for (int i = 0; i < w->n; i++) {
+        if (w->lambda > 0) {
+            generate_stream_process(&process, i, previous_arrival, 1.0 / w->lambda,
+                                    job->config->seed);
+            previous_arrival = process.arrival_time;
+        } else {
+            generate_process(&process, i, real_time, job->config->seed);
+        }
+        process_table_set(&w->table, i, &process);
+    }
+    // Sem a ordem de chegada a carga fica por usar e os seus pontos falham
+    if (process_table_index_arrivals(&w->table) != 0) return;
+
+    if (real_time) {
+        bool truncated;
+        w->horizon = simulation_horizon(&w->table, job->config->horizon_cap, &truncated);
+    }
+    w->ok = true;
+}
+
+static void write_row(SweepJob *job, const SweepPoint *point) {
+    const SweepWorkload *w = &job->workloads[point->workload];
+    const SchedulerStats *s = &point->stats;
+    fprintf(job->out, "%s,%d,%d,", algorithm_name(job->config->algorithm), w->n, point->quantum);
+    if (w->lambda > 0) fprintf(job->out, "%g", w->lambda);
+    fprintf(job->out, ",%llu,%.4f,%.4f,%.4f,%.6f,%d,%.4f,%d,%d,%d,%d,%d,%d\n",
+            (unsigned long long)job->config->seed, s->avg_waiting_time,
+            s->avg_turnaround_time, s->cpu_utilization, s->throughput, s->deadline_misses,
+            s->avg_response_time, s->waiting_percentiles.p99, s->waiting_percentiles.p999,
+            s->turnaround_percentiles.p99, s->turnaround_percentiles.p999,
+            s->response_percentiles.p99, s->response_percentiles.p999);
+}
+
+static void run_point(int index, int worker, void *arg) {
+    SweepJob *job = (SweepJob *)arg;
+    SweepPoint *point = &job->points[index];
+    const SweepWorkload *w = &job->workloads[point->workload];
+
+    ProcessTable view;
+    if (w->ok && process_table_init_view(&view, &w->table) == 0) {
+        Trace usage;
+        trace_init_summary(&usage);
+        if (run_algorithm_in(&job->contexts[worker], job->config->algorithm, &view,
+                             point->quantum, w->horizon, &usage) == 0) {
+            point->stats = algorithm_stats(job->config->algorithm, &view, w->horizon,
+                                           &usage.busy_time, 1);
+            LatencyHistograms *latency = &job->latency[worker];
+            latency_histograms_reset(latency);
+            latency_histograms_add_table(latency, &view);
+            stats_set_percentiles(&point->stats, latency);
+            point->ok = true;
+        }
+        process_table_free(&view);
+    }
+
+    // Escreve, pela ordem da grelha, todas as linhas já disponíveis
+    pthread_mutex_lock(&job->lock);
+    point->done = true;
+    while (job->next_row < job->point_count && job->points[job->next_row].done) {
+        SweepPoint *next = &job->points[job->next_row++];
+        if (next->ok) {
+            write_row(job, next);
+        } else {
+            job->failures++;
+        }
+    }
+    fflush(job->out);
+    pthread_mutex_unlock(&job->lock);
+}
+
+int run_sweep(const SweepConfig *config) {
+    double *quanta = NULL, *sizes = NULL, *lambdas = NULL;
+    int quantum_count = expand_range(&config->quantum, &quanta);
+    int size_count = expand_range(&config->processes, &sizes);
+    int lambda_count = expand_range(&config->lambda, &lambdas);
+    SweepJob job = { .config = config };
+    int threads = (config->threads > 0) ? config->threads : default_thread_count();
+    int workload_count = 0;
+    int status = 1;
+    if (quantum_count < 0 || size_count < 0 || lambda_count < 0) goto done;
+
+    // Grelha por ordem (n, lambda, quantum): a carga é o índice exterior
+    workload_count = size_count * lambda_count;
+    if ((long long)workload_count * quantum_count > MAX_SWEEP_POINTS) {
+        fprintf(stderr, "Erro: a grelha excede %d pontos\n", MAX_SWEEP_POINTS);
+        goto done;
+    }
+    job.point_count = workload_count * quantum_count;
+    job.workloads = calloc(workload_count, sizeof(SweepWorkload));
+    job.points = calloc(job.point_count, sizeof(SweepPoint));
+    job.contexts = calloc(threads, sizeof(SimContext));
+    job.latency = malloc(threads * sizeof(LatencyHistograms));
+    if (!job.workloads || !job.points || !job.contexts || !job.latency) {
+        perror("Erro ao alocar a grelha");
+        goto done;
+    }
+    for (int s = 0; s < size_count; s++) {
+        for (int l = 0; l < lambda_count; l++) {
+            SweepWorkload *w = &job.workloads[s * lambda_count + l];
+            w->n = (int)llround(sizes[s]);
+            w->lambda = lambdas[l];
+        }
+    }
+    for (int p = 0; p < job.point_count; p++) {
+        job.points[p].workload = p / quantum_count;
+        job.points[p].quantum = (int)llround(quanta[p % quantum_count]);
+    }
+
+    job.out = config->output ? fopen(config->output, "w") : stdout;
+    if (!job.out) {
+        perror(config->output);
+        goto done;
+    }
+    fprintf(job.out, "algorithm,processes,quantum,lambda,seed,avg_waiting_time,"
+                     "avg_turnaround_time,cpu_utilization,throughput,deadline_misses,"
+                     "avg_response_time,waiting_p99,waiting_p999,turnaround_p99,"
+                     "turnaround_p999,response_p99,response_p999\n");
+    fflush(job.out);
+
+    for (int t = 0; t < threads; t++) {
+        sim_context_init(&job.contexts[t]);
+    }
+    pthread_mutex_init(&job.lock, NULL);
+    parallel_for(workload_count, threads, generate_workload, &job);
+    parallel_for(job.point_count, threads, run_point, &job);
+    pthread_mutex_destroy(&job.lock);
+
+    if (job.failures > 0) {
+        fprintf(stderr, "Erro: memória insuficiente em %d pontos da grelha\n", job.failures);
+    } else {
+        status = 0;
+    }
+    if (config->output) fclose(job.out);
+
+done:
+    if (job.workloads) {
+        for (int w = 0; w < workload_count; w++) {
+            process_table_free(&job.workloads[w].table);
+        }
+    }
+    if (job.contexts) {
+        for (int t = 0; t < threads; t++) {
+            sim_context_free(&job.contexts[t]);
+        }
+    }
+    free(job.workloads);
+    free(job.points);
+    free(job.contexts);
+    free(job.latency);
+    free(quanta);
+    free(sizes);
+    free(lambdas);
+    return status;
+}
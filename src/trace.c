@@ -0,0 +1,66 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+void trace_init(Trace *trace) {
+    trace->segments = NULL;
+    trace->count = 0;
+    trace->capacity = 0;
+    trace->busy_time = 0;
+    trace->dispatches = 0;
+    trace->releases = 0;
+    trace->keep_segments = true;
+}
+
+void trace_init_summary(Trace *trace) {
+    trace_init(trace);
+    trace->keep_segments = false;
+}
+
+void trace_free(Trace *trace) {
+    bool keep_segments = trace->keep_segments;
+    free(trace->segments);
+    trace_init(trace);
+    trace->keep_segments = keep_segments;
+}
+
+void trace_reset(Trace *trace) {
+    trace->count = 0;
+    trace->busy_time = 0;
+    trace->dispatches = 0;
+    trace->releases = 0;
+}
+
+void trace_add(Trace *trace, int pid, int start, int end, unsigned flags) {
+    if (!trace || end <= start) return;
+
+    trace->busy_time += end - start;
+    trace->dispatches++;
+    if (!trace->keep_segments) return;
+
+    if (trace->count > 0) {
+        TraceSegment *last = &trace->segments[trace->count - 1];
+        if (last->pid == pid && last->end == start && last->flags == 0) {
+            last->end = end;
+            last->flags = flags;
+            return;
+        }
+    }
+
+    if (trace->count == trace->capacity) {
+        int new_capacity = trace->capacity ? 2 * trace->capacity : 256;
+        TraceSegment *segments = realloc(trace->segments, new_capacity * sizeof(TraceSegment));
+        if (!segments) {
+            perror("Erro ao alocar memória para o traço de execução");
+            exit(EXIT_FAILURE);
+        }
+        trace->segments = segments;
+        trace->capacity = new_capacity;
+    }
+
+    TraceSegment *segment = &trace->segments[trace->count++];
+    segment->pid = pid;
+    segment->start = start;
+    segment->end = end;
+    segment->flags = flags;
+}
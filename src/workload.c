@@ -0,0 +1,266 @@
+#include "workload.h"
+#include "process.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// As colunas do ficheiro são usadas diretamente como int
+_Static_assert(sizeof(int) == sizeof(int32_t), "int tem de ter 32 bits");
+
+static uint64_t align_up(uint64_t value) {
+    return (value + WORKLOAD_ALIGN - 1) / WORKLOAD_ALIGN * WORKLOAD_ALIGN;
+}
+
+// Deslocamentos das colunas e tamanho total de um ficheiro com 'count' processos
+static uint64_t workload_layout(uint64_t count, uint64_t offsets[WORKLOAD_COLUMNS]) {
+    uint64_t offset = align_up(sizeof(WorkloadHeader));
+    for (int c = 0; c < WORKLOAD_COLUMNS; c++) {
+        offsets[c] = offset;
+        offset += align_up(count * sizeof(int32_t));
+    }
+    return offset;
+}
+
+static bool header_valid(const WorkloadHeader *header, size_t size) {
+    if (header->magic != WORKLOAD_MAGIC || header->version != WORKLOAD_VERSION ||
+        header->columns != WORKLOAD_COLUMNS || header->count > INT_MAX) {
+        return false;
+    }
+    for (int c = 0; c < WORKLOAD_COLUMNS; c++) {
+        uint64_t offset = header->column_offset[c];
+        if (offset % sizeof(int32_t) != 0 || offset > size ||
+            header->count * sizeof(int32_t) > size - offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int workload_open(MappedWorkload *workload, const char *path, int limit) {
+    memset(workload, 0, sizeof(*workload));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    if ((size_t)st.st_size < sizeof(WorkloadHeader)) {
+        printf("Erro: %s não é um ficheiro de carga válido\n", path);
+        close(fd);
+        return -1;
+    }
+
+    // Mapeamento privado: as páginas só são lidas quando um motor as toca e
+    // nada é copiado nem interpretado no arranque
+    void *map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+    workload->map = map;
+    workload->map_size = st.st_size;
+
+    const WorkloadHeader *header = (const WorkloadHeader *)map;
+    if (!header_valid(header, workload->map_size)) {
+        printf("Erro: %s não é um ficheiro de carga válido\n", path);
+        workload_close(workload);
+        return -1;
+    }
+    if (header->count == 0) {
+        printf("Erro: %s não contém processos\n", path);
+        workload_close(workload);
+        return -1;
+    }
+
+    int n = (int)header->count;
+    if (limit > 0 && limit < n) n = limit;
+
+    ProcessTable *table = &workload->table;
+    if (process_table_init_state(table, n) != 0) {
+        perror("Erro ao alocar memória para processos");
+        workload_close(workload);
+        return -1;
+    }
+    char *base = (char *)map;
+    table->pid = (int *)(base + header->column_offset[0]);
+    table->arrival_time = (int *)(base + header->column_offset[1]);
+    table->burst_time = (int *)(base + header->column_offset[2]);
+    table->priority = (int *)(base + header->column_offset[3]);
+    table->deadline = (int *)(base + header->column_offset[4]);
+    table->period = (int *)(base + header->column_offset[5]);
+    return 0;
+}
+
+void workload_close(MappedWorkload *workload) {
+    process_table_free(&workload->table);
+    if (workload->map) {
+        munmap(workload->map, workload->map_size);
+    }
+    memset(workload, 0, sizeof(*workload));
+}
+
+typedef enum {
+    LINE_BLANK,
+    LINE_DATA,
+    LINE_TEXT       // Cabeçalho (só permitido na primeira linha) ou lixo
+} LineKind;
+
+static LineKind classify_line(const char *line) {
+    while (*line == ' ' || *line == '\t') line++;
+    if (*line == '\0' || *line == '\n' || *line == '\r' || *line == '#') return LINE_BLANK;
+    if ((*line >= '0' && *line <= '9') || *line == '-' || *line == '+') return LINE_DATA;
+    return LINE_TEXT;
+}
+
+// Lê o próximo campo inteiro e avança para depois do separador
+static bool parse_field(char **cursor, int *value) {
+    char *end;
+    errno = 0;
+    long parsed = strtol(*cursor, &end, 10);
+    if (end == *cursor || errno != 0 || parsed < INT_MIN || parsed > INT_MAX) return false;
+    while (*end == ' ' || *end == '\t') end++;
+    if (*end == ',') {
+        end++;
+    } else if (*end != '\0' && *end != '\n' && *end != '\r') {
+        return false;
+    }
+    *value = (int)parsed;
+    *cursor = end;
+    return true;
+}
+
+static bool at_end(const char *cursor) {
+    while (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r') cursor++;
+    return *cursor == '\0';
+}
+
+// Interpreta uma linha de dados; deadline e período são opcionais
+static bool parse_row(char *line, int row[WORKLOAD_COLUMNS]) {
+    char *cursor = line;
+    for (int c = 0; c < WORKLOAD_COLUMNS; c++) {
+        row[c] = 0;
+    }
+    for (int c = 0; c < WORKLOAD_COLUMNS; c++) {
+        if (at_end(cursor)) return c >= 4;
+        if (!parse_field(&cursor, &row[c])) return false;
+    }
+    if (!at_end(cursor)) return false;
+
+    // Chegada, deadline e período não negativos; burst positivo
+    return row[1] >= 0 && row[2] > 0 && row[4] >= 0 && row[5] >= 0;
+}
+
+long long workload_convert_csv(const char *csv_path, const char *out_path) {
+    FILE *in = fopen(csv_path, "r");
+    if (!in) {
+        perror(csv_path);
+        return -1;
+    }
+
+    // Primeira passagem: contar as linhas de dados para dimensionar o ficheiro,
+    // que é depois escrito diretamente em memória mapeada (a carga nunca é
+    // mantida inteira em memória)
+    char *line = NULL;
+    size_t line_capacity = 0;
+    uint64_t count = 0;
+    while (getline(&line, &line_capacity, in) != -1) {
+        if (classify_line(line) == LINE_DATA) count++;
+    }
+    if (count == 0 || count > INT_MAX) {
+        printf("Erro: %s não contém processos válidos\n", csv_path);
+        free(line);
+        fclose(in);
+        return -1;
+    }
+
+    uint64_t offsets[WORKLOAD_COLUMNS];
+    uint64_t size = workload_layout(count, offsets);
+
+    int fd = open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)size) != 0) {
+        perror(out_path);
+        if (fd >= 0) close(fd);
+        free(line);
+        fclose(in);
+        return -1;
+    }
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(out_path);
+        unlink(out_path);
+        free(line);
+        fclose(in);
+        return -1;
+    }
+
+    char *base = (char *)map;
+    int32_t *columns[WORKLOAD_COLUMNS];
+    for (int c = 0; c < WORKLOAD_COLUMNS; c++) {
+        columns[c] = (int32_t *)(base + offsets[c]);
+    }
+
+    // Segunda passagem: preencher as colunas
+    rewind(in);
+    uint64_t written = 0;
+    long long line_number = 0;
+    bool first_line = true;
+    bool ok = true;
+    while (ok && getline(&line, &line_capacity, in) != -1) {
+        line_number++;
+        LineKind kind = classify_line(line);
+        if (kind == LINE_BLANK) continue;
+
+        // Apenas a primeira linha não vazia pode ser um cabeçalho
+        bool header_line = first_line && kind == LINE_TEXT;
+        first_line = false;
+        if (header_line) continue;
+
+        int row[WORKLOAD_COLUMNS];
+        if (kind != LINE_DATA || written >= count || !parse_row(line, row)) {
+            printf("Erro: %s:%lld: linha inválida\n", csv_path, line_number);
+            ok = false;
+            break;
+        }
+        for (int c = 0; c < WORKLOAD_COLUMNS; c++) {
+            columns[c][written] = row[c];
+        }
+        written++;
+    }
+    free(line);
+    fclose(in);
+
+    if (ok && written == count) {
+        WorkloadHeader header = {
+            .magic = WORKLOAD_MAGIC,
+            .version = WORKLOAD_VERSION,
+            .columns = WORKLOAD_COLUMNS,
+            .count = count
+        };
+        memcpy(header.column_offset, offsets, sizeof(offsets));
+        memcpy(map, &header, sizeof(header));
+    } else {
+        ok = false;
+    }
+
+    munmap(map, size);
+    if (!ok) {
+        unlink(out_path);
+        return -1;
+    }
+    return (long long)count;
+}
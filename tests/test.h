@@ -0,0 +1,62 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "process.h"
+
+// Verificações dos testes: cada falha é contada e descrita, sem abortar,
+// para que uma execução mostre todas as diferenças
+static int test_failures = 0;
+
+#define CHECK(cond, ...)                                                   \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            test_failures++;                                               \
+            printf("%s:%d: falhou %s: ", __FILE__, __LINE__, #cond);       \
+            printf(__VA_ARGS__);                                           \
+            printf("\n");                                                  \
+        }                                                                  \
+    } while (0)
+
+// Resultado final: 0 se todas as verificações passaram
+static inline int test_report(const char *name) {
+    if (test_failures == 0) {
+        printf("%s: ok\n", name);
+        return 0;
+    }
+    printf("%s: %d falhas\n", name, test_failures);
+    return 1;
+}
+
+// Gerador próprio dos testes (xorshift), independente do da simulação
+static inline int test_random(uint64_t *state, int min, int max) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return min + (int)(x % (uint64_t)(max - min + 1));
+}
+
+// Copia as colunas de entrada de 'source' para 'table', com o mesmo n
+static inline void test_copy_workload(ProcessTable *table, const ProcessTable *source) {
+    for (int i = 0; i < source->n; i++) {
+        table->pid[i] = source->pid[i];
+        table->arrival_time[i] = source->arrival_time[i];
+        table->burst_time[i] = source->burst_time[i];
+        table->priority[i] = source->priority[i];
+        table->deadline[i] = source->deadline[i];
+        table->period[i] = source->period[i];
+    }
+}
+
+// Linhas i de a e b com os mesmos resultados?
+static inline int test_same_results(const ProcessTable *a, const ProcessTable *b, int i) {
+    return a->completion_time[i] == b->completion_time[i] &&
+           a->waiting_time[i] == b->waiting_time[i] &&
+           a->response_time[i] == b->response_time[i] &&
+           a->deadline_misses[i] == b->deadline_misses[i];
+}
+
+#endif
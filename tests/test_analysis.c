@@ -0,0 +1,94 @@
+// Testes analíticos contra a simulação: em conjuntos síncronos com deadlines
+// restritos, a análise de tempo de resposta (RM) e o QPA (EDF) são exatos,
+// pelo que têm de concordar com um hiperperíodo simulado
+#include "test.h"
+#include "scheduler.h"
+#include "analysis.h"
+#include "jobs.h"
+
+#define MAX_TASKS 5
+
+static int total_misses(const ProcessTable *table) {
+    int misses = 0;
+    for (int i = 0; i < table->n; i++) misses += table->deadline_misses[i];
+    return misses;
+}
+
+// Todas as tarefas chegam em t=0, com D <= T e períodos de hiperperíodo curto
+static void random_task_set(ProcessTable *table, uint64_t *rng) {
+    static const int periods[] = { 2, 3, 4, 5, 6, 8, 10, 12, 15, 20 };
+    for (int i = 0; i < table->n; i++) {
+        int period = periods[test_random(rng, 0, 9)];
+        table->pid[i] = i + 1;
+        table->arrival_time[i] = 0;
+        table->period[i] = period;
+        table->burst_time[i] = test_random(rng, 1, (period + 1) / 2);
+        table->deadline[i] = test_random(rng, table->burst_time[i], period);
+        table->priority[i] = 1;
+    }
+}
+
+// Tempo de resposta de pior caso da RTA = maior resposta simulada (instante
+// crítico em t=0), e escalonável sse a simulação não perde deadlines
+static void check_rm(SimContext *ctx, ProcessTable *table, int horizon, int seed) {
+    long long response[MAX_TASKS];
+    SchedAnalysis analysis = analyze_rm(table, response);
+
+    JobStats jobs;
+    if (job_stats_init(&jobs, table->n) != 0) return;
+    CHECK(run_real_time_jobs_in(ctx, ALG_RM, table, horizon, NULL, NULL, &jobs) == 0,
+          "semente %d", seed);
+    int misses = total_misses(table);
+    CHECK(analysis.schedulable == (misses == 0),
+          "RM, semente %d: análise %s, simulação com %d deadlines perdidos", seed,
+          analysis.schedulable ? "escalonável" : "não escalonável", misses);
+    if (analysis.schedulable) {
+        for (int i = 0; i < table->n; i++) {
+            CHECK(jobs.tasks[i].worst_response == response[i],
+                  "RM, semente %d, tarefa %d: RTA %lld, simulação %d", seed, i, response[i],
+                  jobs.tasks[i].worst_response);
+        }
+    }
+    job_stats_free(&jobs);
+}
+
+// Escalonável sse a simulação não perde deadlines; o primeiro deadline
+// violado do QPA é o primeiro perdido na simulação: nada se perde antes
+// dele e, simulando até ele, há uma perda
+static void check_edf(SimContext *ctx, ProcessTable *table, int horizon, int seed) {
+    SchedAnalysis analysis = analyze_edf(table);
+    CHECK(run_real_time_jobs_in(ctx, ALG_EDF, table, horizon, NULL, NULL, NULL) == 0,
+          "semente %d", seed);
+    int misses = total_misses(table);
+    CHECK(analysis.schedulable == (misses == 0),
+          "EDF, semente %d: análise %s, simulação com %d deadlines perdidos", seed,
+          analysis.schedulable ? "escalonável" : "não escalonável", misses);
+    if (analysis.schedulable || analysis.miss_time < 0) return;
+
+    int miss_time = (int)analysis.miss_time;
+    run_real_time_jobs_in(ctx, ALG_EDF, table, miss_time - 1, NULL, NULL, NULL);
+    CHECK(total_misses(table) == 0, "EDF, semente %d: perda antes de t=%d", seed, miss_time);
+    run_real_time_jobs_in(ctx, ALG_EDF, table, miss_time, NULL, NULL, NULL);
+    CHECK(total_misses(table) > 0, "EDF, semente %d: nenhuma perda até t=%d", seed, miss_time);
+    int i = analysis.failing_index;
+    CHECK(i >= 0 && miss_time >= process_relative_deadline(table, i) &&
+          (miss_time - process_relative_deadline(table, i)) % table->period[i] == 0,
+          "EDF, semente %d: a tarefa %d não tem deadline em t=%d", seed, i, miss_time);
+}
+
+int main(void) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    for (int seed = 1; seed <= 2000; seed++) {
+        uint64_t rng = 0xD1B54A32D192ED03ull * seed;
+        ProcessTable table;
+        if (process_table_init(&table, test_random(&rng, 1, MAX_TASKS)) != 0) return 1;
+        random_task_set(&table, &rng);
+        int horizon = (int)hyperperiod(&table, DEFAULT_HORIZON_CAP);
+        check_rm(&ctx, &table, horizon, seed);
+        check_edf(&ctx, &table, horizon, seed);
+        process_table_free(&table);
+    }
+    sim_context_free(&ctx);
+    return test_report("RTA/QPA vs simulação");
+}
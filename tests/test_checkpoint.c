@@ -0,0 +1,143 @@
+// Checkpoints: gravar não altera a simulação e retomar do último checkpoint
+// dá os mesmos resultados que a execução sem interrupção
+#include "test.h"
+#include "scheduler.h"
+#include "stream.h"
+#include "jobs.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHECKPOINT_PATH "test_checkpoint.tmp"
+
+static void check_same_tables(const ProcessTable *a, const ProcessTable *b, Algorithm algorithm,
+                              const char *how) {
+    for (int i = 0; i < a->n; i++) {
+        CHECK(test_same_results(a, b, i) && a->remaining_time[i] == b->remaining_time[i],
+              "%s %s, processo %d", algorithm_name(algorithm), how, i);
+    }
+}
+
+static void check_same_jobs(const JobStats *a, const JobStats *b, int n, Algorithm algorithm) {
+    for (int i = 0; i < n; i++) {
+        const TaskJobStats *x = &a->tasks[i], *y = &b->tasks[i];
+        CHECK(x->completed == y->completed && x->late == y->late && x->dropped == y->dropped &&
+              x->worst_response == y->worst_response &&
+              x->response_histogram.count == y->response_histogram.count,
+              "%s, tarefa %d", algorithm_name(algorithm), i);
+    }
+}
+
+// RM/EDF: checkpoints a cada 'interval', retoma do último
+static void test_periodic(SimContext *ctx) {
+    int n = 40;
+    int horizon = 200000;
+    ProcessTable full, checkpointed;
+    process_table_init(&full, n);
+    process_table_init(&checkpointed, n);
+    generate_processes(&full, true, 11);
+    generate_processes(&checkpointed, true, 11);
+
+    for (Algorithm algorithm = ALG_RM; algorithm <= ALG_EDF; algorithm++) {
+        JobStats full_jobs, saved_jobs, resumed_jobs;
+        job_stats_init(&full_jobs, n);
+        job_stats_init(&saved_jobs, n);
+        job_stats_init(&resumed_jobs, n);
+        CHECK(run_real_time_jobs_in(ctx, algorithm, &full, horizon, NULL, NULL, &full_jobs) == 0,
+              "%s", algorithm_name(algorithm));
+
+        remove(CHECKPOINT_PATH);
+        CheckpointConfig save = { .path = CHECKPOINT_PATH, .interval = 70001 };
+        CHECK(run_real_time_jobs_in(ctx, algorithm, &checkpointed, horizon, NULL, &save,
+                                    &saved_jobs) == 0, "%s", algorithm_name(algorithm));
+        check_same_tables(&full, &checkpointed, algorithm, "com checkpoints");
+        check_same_jobs(&full_jobs, &saved_jobs, n, algorithm);
+
+        // A retoma parte de t=140002 com o estado gravado, não do da tabela
+        process_table_reset(&checkpointed);
+        CheckpointConfig resume = { .resume = CHECKPOINT_PATH, .interval = save.interval };
+        Trace trace;
+        trace_init_summary(&trace);
+        CHECK(run_real_time_jobs_in(ctx, algorithm, &checkpointed, horizon, &trace, &resume,
+                                    &resumed_jobs) == 0, "%s", algorithm_name(algorithm));
+        check_same_tables(&full, &checkpointed, algorithm, "retomado");
+        check_same_jobs(&full_jobs, &resumed_jobs, n, algorithm);
+
+        // O checkpoint é de outro algoritmo (e sem jobs, de outro cabeçalho)
+        Algorithm other = (algorithm == ALG_RM) ? ALG_EDF : ALG_RM;
+        CHECK(run_real_time_jobs_in(ctx, other, &checkpointed, horizon, NULL, &resume,
+                                    &resumed_jobs) != 0, "%s", algorithm_name(algorithm));
+        CHECK(run_real_time_jobs_in(ctx, algorithm, &checkpointed, horizon, NULL, &resume,
+                                    NULL) != 0, "%s", algorithm_name(algorithm));
+
+        job_stats_free(&full_jobs);
+        job_stats_free(&saved_jobs);
+        job_stats_free(&resumed_jobs);
+    }
+    process_table_free(&full);
+    process_table_free(&checkpointed);
+}
+
+static int same_stat(const RunningStat *a, const RunningStat *b) {
+    return a->count == b->count && a->mean == b->mean && a->m2 == b->m2;
+}
+
+static void check_same_stream(const StreamResult *a, const StreamResult *b, Algorithm algorithm,
+                              const char *how) {
+    const OnlineStats *x = &a->online, *y = &b->online;
+    CHECK(same_stat(&x->waiting_time, &y->waiting_time) &&
+          same_stat(&x->turnaround_time, &y->turnaround_time) &&
+          same_stat(&x->response_time, &y->response_time) &&
+          x->busy_time == y->busy_time && x->end_time == y->end_time &&
+          memcmp(&x->latency, &y->latency, sizeof(x->latency)) == 0 &&
+          a->peak_live == b->peak_live,
+          "%s %s", algorithm_name(algorithm), how);
+}
+
+// Streaming com chegadas rápidas, para que o pool cresça e a retoma tenha
+// de o repor com a capacidade gravada
+static void test_stream(SimContext *ctx) {
+    const Algorithm algorithms[] = { ALG_FCFS, ALG_SJF, ALG_PRIORITY_NP, ALG_PRIORITY_P, ALG_RR };
+    int count = 100000;
+    double interarrival = 3.0;
+    for (size_t a = 0; a < sizeof(algorithms) / sizeof(algorithms[0]); a++) {
+        Algorithm algorithm = algorithms[a];
+        int quantum = 3;
+        GeneratedSource source;
+        StreamResult full, saved, resumed;
+
+        generated_source_init(&source, count, 5, interarrival);
+        CHECK(run_stream_in(ctx, algorithm, &source.base, quantum, NULL, &full) == 0, "%s",
+              algorithm_name(algorithm));
+        CHECK(full.peak_live > 1024, "%s: o pool não cresceu (pico %d)",
+              algorithm_name(algorithm), full.peak_live);
+
+        remove(CHECKPOINT_PATH);
+        CheckpointConfig save = { .path = CHECKPOINT_PATH, .interval = 100000 };
+        generated_source_init(&source, count, 5, interarrival);
+        CHECK(run_stream_in(ctx, algorithm, &source.base, quantum, &save, &saved) == 0, "%s",
+              algorithm_name(algorithm));
+        check_same_stream(&full, &saved, algorithm, "com checkpoints");
+
+        CheckpointConfig resume = { .resume = CHECKPOINT_PATH, .interval = save.interval };
+        generated_source_init(&source, count, 5, interarrival);
+        CHECK(run_stream_in(ctx, algorithm, &source.base, quantum, &resume, &resumed) == 0, "%s",
+              algorithm_name(algorithm));
+        check_same_stream(&full, &resumed, algorithm, "retomado");
+
+        // Outra semente: a fonte recusa o checkpoint
+        generated_source_init(&source, count, 6, interarrival);
+        CHECK(run_stream_in(ctx, algorithm, &source.base, quantum, &resume, &resumed) != 0, "%s",
+              algorithm_name(algorithm));
+    }
+}
+
+int main(void) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    printf("(as retomas recusadas de propósito escrevem erros de checkpoint)\n");
+    test_periodic(&ctx);
+    test_stream(&ctx);
+    sim_context_free(&ctx);
+    remove(CHECKPOINT_PATH);
+    return test_report("checkpoint e retoma");
+}
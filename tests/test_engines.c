@@ -0,0 +1,236 @@
+// Motores orientados a eventos contra uma simulação de referência que avança
+// uma unidade de tempo de cada vez, com as mesmas regras de escolha e de
+// desempate (menor chave, depois menor índice)
+#include "test.h"
+#include "scheduler.h"
+
+#define MAX_TASKS 16
+
+// Índices por (chegada, índice), como o cursor de chegadas dos motores
+static void arrival_order(const ProcessTable *t, int *order) {
+    for (int i = 0; i < t->n; i++) {
+        int k = i;
+        while (k > 0 && t->arrival_time[order[k - 1]] > t->arrival_time[i]) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = i;
+    }
+}
+
+static int ready_key(Algorithm algorithm, const ProcessTable *t, int i) {
+    switch (algorithm) {
+        case ALG_SJF: return t->burst_time[i];
+        default:      return t->priority[i];
+    }
+}
+
+// Menor (chave, índice) entre os processos chegados e por terminar
+static int pick(Algorithm algorithm, const ProcessTable *t, const bool *arrived, int exclude) {
+    int best = -1;
+    for (int i = 0; i < t->n; i++) {
+        if (!arrived[i] || t->remaining_time[i] == 0 || i == exclude) continue;
+        if (best == -1 || ready_key(algorithm, t, i) < ready_key(algorithm, t, best)) best = i;
+    }
+    return best;
+}
+
+// FCFS, SJF, Priority e RR, uma unidade de tempo por iteração
+static void reference_aperiodic(Algorithm algorithm, ProcessTable *t, int quantum) {
+    int n = t->n;
+    int order[MAX_TASKS], fifo[MAX_TASKS];
+    bool arrived[MAX_TASKS] = {false};
+    int head = 0, size = 0;
+    arrival_order(t, order);
+    for (int i = 0; i < n; i++) {
+        t->remaining_time[i] = t->burst_time[i];
+        t->completion_time[i] = t->waiting_time[i] = t->response_time[i] = 0;
+        t->deadline_misses[i] = 0;
+    }
+    bool uses_fifo = (algorithm == ALG_FCFS || algorithm == ALG_RR);
+
+    int next = 0, current = -1, slice = 0, done = 0, time = 0;
+    while (done < n) {
+        while (next < n && t->arrival_time[order[next]] <= time) {
+            int i = order[next++];
+            arrived[i] = true;
+            if (uses_fifo) fifo[(head + size++) % MAX_TASKS] = i;
+        }
+        if (algorithm == ALG_PRIORITY_P) {
+            current = pick(algorithm, t, arrived, -1);
+        } else if (current == -1 && uses_fifo && size > 0) {
+            current = fifo[head];
+            head = (head + 1) % MAX_TASKS;
+            size--;
+        } else if (current == -1 && !uses_fifo) {
+            current = pick(algorithm, t, arrived, -1);
+        }
+        if (current == -1) {
+            time++;
+            continue;
+        }
+
+        if (t->remaining_time[current] == t->burst_time[current]) {
+            t->response_time[current] = time - t->arrival_time[current];
+        }
+        t->remaining_time[current]--;
+        time++;
+        slice++;
+        if (t->remaining_time[current] == 0) {
+            t->completion_time[current] = time;
+            t->waiting_time[current] = time - t->arrival_time[current] - t->burst_time[current];
+            done++;
+            current = -1;
+            slice = 0;
+        } else if (algorithm == ALG_RR && slice == quantum) {
+            // Quem chegou durante o quantum entra na fila antes do preemptado
+            while (next < n && t->arrival_time[order[next]] <= time) {
+                int i = order[next++];
+                arrived[i] = true;
+                fifo[(head + size++) % MAX_TASKS] = i;
+            }
+            fifo[(head + size++) % MAX_TASKS] = current;
+            current = -1;
+            slice = 0;
+        }
+    }
+}
+
+// RM e EDF em [0, horizon): um job pendente na libertação seguinte ou no fim
+// do horizonte (com o deadline ultrapassado) perde o deadline, tal como um
+// job concluído depois dele
+static void reference_periodic(Algorithm algorithm, ProcessTable *t, int horizon) {
+    int n = t->n;
+    int next_release[MAX_TASKS], release[MAX_TASKS], deadline[MAX_TASKS];
+    bool active[MAX_TASKS];
+    for (int i = 0; i < n; i++) {
+        t->remaining_time[i] = 0;
+        t->completion_time[i] = t->waiting_time[i] = t->response_time[i] = 0;
+        t->deadline_misses[i] = 0;
+        next_release[i] = t->arrival_time[i];
+        release[i] = deadline[i] = 0;
+        active[i] = (algorithm == ALG_EDF || t->period[i] > 0) && next_release[i] < horizon;
+    }
+
+    for (int time = 0; time < horizon; time++) {
+        for (int i = 0; i < n; i++) {
+            if (!active[i] || next_release[i] != time) continue;
+            if (t->remaining_time[i] > 0) t->deadline_misses[i]++;
+            t->remaining_time[i] = t->burst_time[i];
+            release[i] = time;
+            if (t->period[i] > 0) {
+                deadline[i] = time + process_relative_deadline(t, i);
+                next_release[i] += t->period[i];
+                active[i] = next_release[i] < horizon;
+            } else {
+                deadline[i] = t->deadline[i];
+                active[i] = false;
+            }
+        }
+
+        int best = -1;
+        for (int i = 0; i < n; i++) {
+            if (t->remaining_time[i] == 0) continue;
+            int key = (algorithm == ALG_RM) ? t->period[i] : deadline[i];
+            int best_key = (best == -1) ? 0 : (algorithm == ALG_RM) ? t->period[best] : deadline[best];
+            if (best == -1 || key < best_key) best = i;
+        }
+        if (best == -1) continue;
+
+        if (t->remaining_time[best] == t->burst_time[best]) {
+            t->response_time[best] = time - release[best];
+        }
+        if (--t->remaining_time[best] == 0) {
+            t->completion_time[best] = time + 1;
+            t->waiting_time[best] = time + 1 - t->arrival_time[best] - t->burst_time[best];
+            if (time + 1 > deadline[best]) t->deadline_misses[best]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (t->remaining_time[i] > 0 && deadline[i] <= horizon) t->deadline_misses[i]++;
+    }
+}
+
+static void random_aperiodic(ProcessTable *t, uint64_t *rng) {
+    for (int i = 0; i < t->n; i++) {
+        t->pid[i] = i + 1;
+        t->arrival_time[i] = test_random(rng, 0, 20);
+        t->burst_time[i] = test_random(rng, 1, 8);
+        t->priority[i] = test_random(rng, 1, 4);
+        t->deadline[i] = 0;
+        t->period[i] = 0;
+    }
+}
+
+// Tarefas com deadline restrito (D <= T), algumas aperiódicas (só EDF as liberta)
+static void random_periodic(ProcessTable *t, uint64_t *rng) {
+    for (int i = 0; i < t->n; i++) {
+        t->pid[i] = i + 1;
+        t->arrival_time[i] = test_random(rng, 0, 6);
+        t->priority[i] = 1;
+        if (test_random(rng, 0, 5) == 0) {
+            t->period[i] = 0;
+            t->burst_time[i] = test_random(rng, 1, 6);
+            t->deadline[i] = t->arrival_time[i] + test_random(rng, t->burst_time[i], 15);
+        } else {
+            t->period[i] = test_random(rng, 2, 12);
+            t->burst_time[i] = test_random(rng, 1, t->period[i] / 2 + 1);
+            t->deadline[i] = t->arrival_time[i] + test_random(rng, t->burst_time[i], t->period[i]);
+        }
+    }
+}
+
+static void compare(Algorithm algorithm, const ProcessTable *engine, const ProcessTable *reference,
+                    int seed) {
+    for (int i = 0; i < engine->n; i++) {
+        CHECK(test_same_results(engine, reference, i),
+              "%s, semente %d, processo %d: motor (%d, %d, %d, %d), referência (%d, %d, %d, %d)",
+              algorithm_name(algorithm), seed, i,
+              engine->completion_time[i], engine->waiting_time[i], engine->response_time[i],
+              engine->deadline_misses[i], reference->completion_time[i],
+              reference->waiting_time[i], reference->response_time[i],
+              reference->deadline_misses[i]);
+    }
+}
+
+int main(void) {
+    const Algorithm aperiodic[] = { ALG_FCFS, ALG_SJF, ALG_PRIORITY_NP, ALG_PRIORITY_P, ALG_RR };
+    SimContext ctx;
+    sim_context_init(&ctx);
+
+    for (int seed = 1; seed <= 500; seed++) {
+        uint64_t rng = 0x9E3779B97F4A7C15ull * seed;
+        int n = test_random(&rng, 1, MAX_TASKS);
+        ProcessTable engine, reference;
+        process_table_init(&engine, n);
+        process_table_init(&reference, n);
+
+        random_aperiodic(&engine, &rng);
+        test_copy_workload(&reference, &engine);
+        for (size_t a = 0; a < sizeof(aperiodic) / sizeof(aperiodic[0]); a++) {
+            int quantum = test_random(&rng, 1, 4);
+            process_table_reset(&engine);
+            CHECK(run_algorithm_in(&ctx, aperiodic[a], &engine, quantum, 0, NULL) == 0,
+                  "%s, semente %d", algorithm_name(aperiodic[a]), seed);
+            reference_aperiodic(aperiodic[a], &reference, quantum);
+            compare(aperiodic[a], &engine, &reference, seed);
+        }
+
+        random_periodic(&engine, &rng);
+        test_copy_workload(&reference, &engine);
+        int horizon = test_random(&rng, 20, 120);
+        for (Algorithm a = ALG_RM; a <= ALG_EDF; a++) {
+            process_table_reset(&engine);
+            CHECK(run_algorithm_in(&ctx, a, &engine, 0, horizon, NULL) == 0,
+                  "%s, semente %d", algorithm_name(a), seed);
+            reference_periodic(a, &reference, horizon);
+            compare(a, &engine, &reference, seed);
+        }
+
+        process_table_free(&engine);
+        process_table_free(&reference);
+    }
+
+    sim_context_free(&ctx);
+    return test_report("motores vs referência por unidade de tempo");
+}
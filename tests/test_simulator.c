@@ -0,0 +1,115 @@
+// Simulador incremental contra os motores de run_algorithm: a mesma carga,
+// acrescentada de uma vez ou à medida que chega, dá os mesmos resultados
+#include "test.h"
+#include "simulator.h"
+#include "analysis.h"
+
+static void check_rows(const Simulator *sim, const ProcessTable *table, Algorithm algorithm,
+                       const char *how) {
+    CHECK(simulator_process_count(sim) == table->n, "%s %s", algorithm_name(algorithm), how);
+    for (int i = 0; i < table->n; i++) {
+        Process p;
+        if (simulator_get_process(sim, i, &p) != 0) continue;
+        CHECK(p.completion_time == table->completion_time[i] &&
+              p.waiting_time == table->waiting_time[i] &&
+              p.response_time == table->response_time[i],
+              "%s %s, processo %d: simulador (%d, %d, %d), motor (%d, %d, %d)",
+              algorithm_name(algorithm), how, i, p.completion_time, p.waiting_time,
+              p.response_time, table->completion_time[i], table->waiting_time[i],
+              table->response_time[i]);
+    }
+}
+
+static void add_all(Simulator *sim, const ProcessTable *table) {
+    for (int i = 0; i < table->n; i++) {
+        Process p;
+        process_table_get(table, i, &p);
+        CHECK(simulator_add_process(sim, &p) == i, "processo %d", i);
+    }
+}
+
+// Cargas não periódicas com mais processos do que a capacidade inicial
+static void test_aperiodic(SimContext *ctx) {
+    const Algorithm algorithms[] = { ALG_FCFS, ALG_SJF, ALG_PRIORITY_NP, ALG_PRIORITY_P, ALG_RR };
+    int n = 2000;
+    ProcessTable table;
+    process_table_init(&table, n);
+
+    // Chegadas já ordenadas pelo índice, para poderem ser acrescentadas em curso
+    Process p = {0};
+    for (int i = 0; i < n; i++) {
+        generate_stream_process(&p, i, p.arrival_time, 6.0, 42);
+        process_table_set(&table, i, &p);
+    }
+
+    for (size_t a = 0; a < sizeof(algorithms) / sizeof(algorithms[0]); a++) {
+        Algorithm algorithm = algorithms[a];
+        int quantum = 3;
+        CHECK(run_algorithm(algorithm, &table, quantum, 0, NULL) == 0, "%s",
+              algorithm_name(algorithm));
+
+        // Toda a carga de uma vez, com o contexto do chamador
+        Simulator *sim = simulator_create_in(ctx, algorithm, quantum);
+        CHECK(sim != NULL, "%s", algorithm_name(algorithm));
+        if (!sim) continue;
+        add_all(sim, &table);
+        simulator_run(sim);
+        check_rows(sim, &table, algorithm, "de uma vez");
+        CHECK(simulator_completed(sim) == n, "%s", algorithm_name(algorithm));
+
+        // Depois do reset, cada processo acrescentado com a simulação em curso,
+        // uma unidade antes da chegada (na própria chegada, um quantum que
+        // acabe nesse instante já teria recolocado o processo antes dele)
+        simulator_reset(sim);
+        for (int i = 0; i < n; i++) {
+            process_table_get(&table, i, &p);
+            simulator_advance_to(sim, p.arrival_time - 1);
+            CHECK(simulator_add_process(sim, &p) == i, "%s, processo %d",
+                  algorithm_name(algorithm), i);
+        }
+        simulator_run(sim);
+        check_rows(sim, &table, algorithm, "em curso");
+        simulator_destroy(sim);
+    }
+    process_table_free(&table);
+}
+
+// RM/EDF até ao horizonte, em avanços parciais
+static void test_periodic(void) {
+    int n = 100;
+    ProcessTable table;
+    process_table_init(&table, n);
+    generate_processes(&table, true, 7);
+    int horizon = 5000;
+
+    for (Algorithm algorithm = ALG_RM; algorithm <= ALG_EDF; algorithm++) {
+        CHECK(run_algorithm(algorithm, &table, 0, horizon, NULL) == 0, "%s",
+              algorithm_name(algorithm));
+        int misses = 0;
+        for (int i = 0; i < n; i++) misses += table.deadline_misses[i];
+
+        Simulator *sim = simulator_create(algorithm, 0);
+        CHECK(sim != NULL, "%s", algorithm_name(algorithm));
+        if (!sim) continue;
+        add_all(sim, &table);
+        for (int time = 0; time < horizon; time += 37) {
+            simulator_advance_to(sim, time);
+        }
+        simulator_advance_to(sim, horizon);
+        CHECK(simulator_time(sim) == horizon, "%s", algorithm_name(algorithm));
+        check_rows(sim, &table, algorithm, "em avanços parciais");
+        CHECK(simulator_stats(sim).deadline_misses == misses, "%s: %d deadlines perdidos, motor %d",
+              algorithm_name(algorithm), simulator_stats(sim).deadline_misses, misses);
+        simulator_destroy(sim);
+    }
+    process_table_free(&table);
+}
+
+int main(void) {
+    SimContext ctx;
+    sim_context_init(&ctx);
+    test_aperiodic(&ctx);
+    test_periodic();
+    sim_context_free(&ctx);
+    return test_report("simulador incremental vs run_algorithm");
+}